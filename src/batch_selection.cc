@@ -0,0 +1,307 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#include "batch_selection.h"
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define LHCO_X86_SIMD 1
+#endif
+
+namespace lhco {
+struct ObjectCut {
+    int typ;
+    int btag_min;
+    int btag_max;
+    double pt;
+    double eta;
+};
+
+ObjectCut mkObjectCut(ObjectKind kind, const Pt &pt, const Eta &eta) {
+    ObjectCut cut{4, INT_MIN, INT_MAX, pt.value, eta.value};
+    switch (kind) {
+    case ObjectKind::Photon:
+        cut.typ = 0;
+        break;
+    case ObjectKind::Electron:
+        cut.typ = 1;
+        break;
+    case ObjectKind::Muon:
+        cut.typ = 2;
+        break;
+    case ObjectKind::Tau:
+        cut.typ = 3;
+        break;
+    case ObjectKind::NormalJet:  // btag > 0.5 is false
+        cut.btag_max = 0;
+        break;
+    case ObjectKind::Bjet:  // btag > 0.5 is true
+        cut.btag_min = 1;
+        break;
+    default:
+        break;
+    }
+    return cut;
+}
+
+void selectScalar(const ObjectCut &cut, const EventBatch &batch,
+                  std::size_t first, std::uint8_t *mask) {
+    const int *typ = batch.typ().data();
+    const int *btag = batch.btag().data();
+    const double *pt = batch.pt().data();
+    const double *eta = batch.eta().data();
+    for (std::size_t i = first; i < batch.num_objects(); ++i) {
+        mask[i] = typ[i] == cut.typ && btag[i] >= cut.btag_min &&
+                  btag[i] <= cut.btag_max && pt[i] > cut.pt &&
+                  std::abs(eta[i]) < cut.eta;
+    }
+}
+
+#ifdef LHCO_X86_SIMD
+__attribute__((target("sse2"))) void selectSSE2(const ObjectCut &cut,
+                                                const EventBatch &batch,
+                                                std::uint8_t *mask) {
+    const int *typ = batch.typ().data();
+    const int *btag = batch.btag().data();
+    const double *pt = batch.pt().data();
+    const double *eta = batch.eta().data();
+    const __m128d ptcut = _mm_set1_pd(cut.pt);
+    const __m128d etacut = _mm_set1_pd(cut.eta);
+    const __m128d sign = _mm_set1_pd(-0.0);
+    const __m128i typcut = _mm_set1_epi32(cut.typ);
+    const __m128i btag_min = _mm_set1_epi32(cut.btag_min);
+    const __m128i btag_max = _mm_set1_epi32(cut.btag_max);
+
+    const std::size_t n = batch.num_objects() / 2 * 2;
+    for (std::size_t i = 0; i < n; i += 2) {
+        const __m128d p = _mm_loadu_pd(pt + i);
+        const __m128d e = _mm_andnot_pd(sign, _mm_loadu_pd(eta + i));
+        const int kin = _mm_movemask_pd(
+            _mm_and_pd(_mm_cmpgt_pd(p, ptcut), _mm_cmplt_pd(e, etacut)));
+        const __m128i t = _mm_loadl_epi64(
+            reinterpret_cast<const __m128i *>(typ + i));
+        const __m128i b = _mm_loadl_epi64(
+            reinterpret_cast<const __m128i *>(btag + i));
+        const __m128i out = _mm_or_si128(_mm_cmplt_epi32(b, btag_min),
+                                         _mm_cmpgt_epi32(b, btag_max));
+        const __m128i in = _mm_andnot_si128(out, _mm_cmpeq_epi32(t, typcut));
+        const int kind = _mm_movemask_ps(_mm_castsi128_ps(in));
+        const int bits = kin & kind;
+        mask[i] = bits & 1;
+        mask[i + 1] = (bits >> 1) & 1;
+    }
+    selectScalar(cut, batch, n, mask);
+}
+
+__attribute__((target("avx2"))) void selectAVX2(const ObjectCut &cut,
+                                                const EventBatch &batch,
+                                                std::uint8_t *mask) {
+    const int *typ = batch.typ().data();
+    const int *btag = batch.btag().data();
+    const double *pt = batch.pt().data();
+    const double *eta = batch.eta().data();
+    const __m256d ptcut = _mm256_set1_pd(cut.pt);
+    const __m256d etacut = _mm256_set1_pd(cut.eta);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    const __m128i typcut = _mm_set1_epi32(cut.typ);
+    const __m128i btag_min = _mm_set1_epi32(cut.btag_min);
+    const __m128i btag_max = _mm_set1_epi32(cut.btag_max);
+
+    const std::size_t n = batch.num_objects() / 4 * 4;
+    for (std::size_t i = 0; i < n; i += 4) {
+        const __m256d p = _mm256_loadu_pd(pt + i);
+        const __m256d e = _mm256_andnot_pd(sign, _mm256_loadu_pd(eta + i));
+        const int kin = _mm256_movemask_pd(
+            _mm256_and_pd(_mm256_cmp_pd(p, ptcut, _CMP_GT_OQ),
+                          _mm256_cmp_pd(e, etacut, _CMP_LT_OQ)));
+        const __m128i t =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(typ + i));
+        const __m128i b =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(btag + i));
+        const __m128i out = _mm_or_si128(_mm_cmplt_epi32(b, btag_min),
+                                         _mm_cmpgt_epi32(b, btag_max));
+        const __m128i in = _mm_andnot_si128(out, _mm_cmpeq_epi32(t, typcut));
+        const int kind = _mm_movemask_ps(_mm_castsi128_ps(in));
+        const int bits = kin & kind;
+        mask[i] = bits & 1;
+        mask[i + 1] = (bits >> 1) & 1;
+        mask[i + 2] = (bits >> 2) & 1;
+        mask[i + 3] = (bits >> 3) & 1;
+    }
+    selectScalar(cut, batch, n, mask);
+}
+#endif  // LHCO_X86_SIMD
+
+SimdLevel detectSimdLevel() {
+#ifdef LHCO_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) { return SimdLevel::AVX2; }
+    if (__builtin_cpu_supports("sse2")) { return SimdLevel::SSE2; }
+#endif
+    return SimdLevel::Scalar;
+}
+
+SimdLevel &currentSimdLevel() {
+    static SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+SimdLevel simdLevel() { return currentSimdLevel(); }
+
+SimdLevel setSimdLevel(SimdLevel level) {
+    static const SimdLevel supported = detectSimdLevel();
+    currentSimdLevel() = level < supported ? level : supported;
+    return currentSimdLevel();
+}
+
+Mask selectObjects(ObjectKind kind, const Pt &pt, const Eta &eta,
+                   const EventBatch &batch) {
+    const ObjectCut cut = mkObjectCut(kind, pt, eta);
+    Mask mask(batch.num_objects());
+    switch (simdLevel()) {
+#ifdef LHCO_X86_SIMD
+    case SimdLevel::AVX2:
+        selectAVX2(cut, batch, mask.data());
+        break;
+    case SimdLevel::SSE2:
+        selectSSE2(cut, batch, mask.data());
+        break;
+#endif
+    default:
+        selectScalar(cut, batch, 0, mask.data());
+        break;
+    }
+    return mask;
+}
+
+Mask bjetMask(const EventBatch &batch) {
+    Mask mask(batch.num_objects());
+    const auto &typ = batch.typ();
+    const auto &btag = batch.btag();
+    for (std::size_t i = 0; i < mask.size(); ++i) {
+        mask[i] = isKind(ObjectKind::Bjet, typ[i], btag[i]);
+    }
+    return mask;
+}
+
+std::vector<int> countPerEvent(const Mask &mask, const EventBatch &batch) {
+    const auto &offsets = batch.offsets();
+    std::vector<int> counts(batch.size());
+    for (std::size_t i = 0; i < counts.size(); ++i) {
+        int count = 0;
+        for (std::size_t j = offsets[i]; j < offsets[i + 1]; ++j) {
+            count += mask[j];
+        }
+        counts[i] = count;
+    }
+    return counts;
+}
+
+std::vector<int> numOfObjects(ObjectKind kind, const EventBatch &batch) {
+    Mask mask(batch.num_objects());
+    const auto &typ = batch.typ();
+    const auto &btag = batch.btag();
+    for (std::size_t i = 0; i < mask.size(); ++i) {
+        mask[i] = isKind(kind, typ[i], btag[i]);
+    }
+    return countPerEvent(mask, batch);
+}
+
+std::vector<int> numOfObjects(ObjectKind kind, const Pt &pt, const Eta &eta,
+                              const EventBatch &batch) {
+    return countPerEvent(selectObjects(kind, pt, eta, batch), batch);
+}
+
+std::vector<int> numPhoton(const EventBatch &batch) {
+    return numOfObjects(ObjectKind::Photon, batch);
+}
+
+std::vector<int> numPhoton(const Pt &pt, const Eta &eta,
+                           const EventBatch &batch) {
+    return numOfObjects(ObjectKind::Photon, pt, eta, batch);
+}
+
+std::vector<int> numElectron(const EventBatch &batch) {
+    return numOfObjects(ObjectKind::Electron, batch);
+}
+
+std::vector<int> numElectron(const Pt &pt, const Eta &eta,
+                             const EventBatch &batch) {
+    return numOfObjects(ObjectKind::Electron, pt, eta, batch);
+}
+
+std::vector<int> numMuon(const EventBatch &batch) {
+    return numOfObjects(ObjectKind::Muon, batch);
+}
+
+std::vector<int> numMuon(const Pt &pt, const Eta &eta,
+                         const EventBatch &batch) {
+    return numOfObjects(ObjectKind::Muon, pt, eta, batch);
+}
+
+std::vector<int> numTau(const EventBatch &batch) {
+    return numOfObjects(ObjectKind::Tau, batch);
+}
+
+std::vector<int> numTau(const Pt &pt, const Eta &eta,
+                        const EventBatch &batch) {
+    return numOfObjects(ObjectKind::Tau, pt, eta, batch);
+}
+
+std::vector<int> numNormalJet(const EventBatch &batch) {
+    return numOfObjects(ObjectKind::NormalJet, batch);
+}
+
+std::vector<int> numNormalJet(const Pt &pt, const Eta &eta,
+                              const EventBatch &batch) {
+    return numOfObjects(ObjectKind::NormalJet, pt, eta, batch);
+}
+
+std::vector<int> numBjet(const EventBatch &batch) {
+    return numOfObjects(ObjectKind::Bjet, batch);
+}
+
+std::vector<int> numBjet(const Pt &pt, const Eta &eta,
+                         const EventBatch &batch) {
+    return numOfObjects(ObjectKind::Bjet, pt, eta, batch);
+}
+
+std::vector<int> numAllJet(const EventBatch &batch) {
+    return numOfObjects(ObjectKind::AllJet, batch);
+}
+
+std::vector<int> numAllJet(const Pt &pt, const Eta &eta,
+                           const EventBatch &batch) {
+    return numOfObjects(ObjectKind::AllJet, pt, eta, batch);
+}
+
+std::vector<double> missingET(const EventBatch &batch) {
+    // As in parseEvent, the last object that is not a photon, lepton, or jet
+    // is the missing energy.
+    const auto &offsets = batch.offsets();
+    const auto &typ = batch.typ();
+    const auto &pt = batch.pt();
+    std::vector<double> met(batch.size(), 0.0);
+    for (std::size_t i = 0; i < met.size(); ++i) {
+        for (std::size_t j = offsets[i + 1]; j > offsets[i]; --j) {
+            if (typ[j - 1] < 0 || typ[j - 1] > 4) {
+                met[i] = pt[j - 1];
+                break;
+            }
+        }
+    }
+    return met;
+}
+
+Mask missingETAbove(const Pt &met, const EventBatch &batch) {
+    const std::vector<double> values = missingET(batch);
+    Mask mask(values.size());
+    for (std::size_t i = 0; i < mask.size(); ++i) {
+        mask[i] = values[i] > met.value;
+    }
+    return mask;
+}
+}  // namespace lhco
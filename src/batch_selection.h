@@ -0,0 +1,91 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#ifndef SRC_BATCH_SELECTION_H_
+#define SRC_BATCH_SELECTION_H_
+
+#include <cstdint>
+#include <vector>
+#include "event_batch.h"
+#include "kinematics.h"
+#include "object.h"
+
+namespace lhco {
+using Mask = std::vector<std::uint8_t>;
+
+/*
+ * Instruction sets used by the kernels below. The best one supported by the
+ * CPU is chosen at runtime. setSimdLevel can lower it (e.g., for comparing
+ * the results), but never raise it beyond what the CPU supports.
+ */
+enum class SimdLevel { Scalar, SSE2, AVX2 };
+
+SimdLevel simdLevel();
+
+SimdLevel setSimdLevel(SimdLevel level);
+
+/*
+ * Per-object mask of the batch, 1 for the objects of the given kind with
+ * pt > ptcut and |eta| < etacut.
+ */
+Mask selectObjects(ObjectKind kind, const Pt &pt, const Eta &eta,
+                   const EventBatch &batch);
+
+// Per-object mask of the b-tagged jets.
+Mask bjetMask(const EventBatch &batch);
+
+// Number of objects of the given kind in each event of the batch.
+std::vector<int> numOfObjects(ObjectKind kind, const EventBatch &batch);
+
+std::vector<int> numOfObjects(ObjectKind kind, const Pt &pt, const Eta &eta,
+                              const EventBatch &batch);
+
+// Adds up a per-object mask into the multiplicity of each event.
+std::vector<int> countPerEvent(const Mask &mask, const EventBatch &batch);
+
+/*
+ * The same counts as numPhoton, numElectron, ... in lhco.h, for every event
+ * of the batch at once.
+ */
+std::vector<int> numPhoton(const EventBatch &batch);
+
+std::vector<int> numPhoton(const Pt &pt, const Eta &eta,
+                           const EventBatch &batch);
+
+std::vector<int> numElectron(const EventBatch &batch);
+
+std::vector<int> numElectron(const Pt &pt, const Eta &eta,
+                             const EventBatch &batch);
+
+std::vector<int> numMuon(const EventBatch &batch);
+
+std::vector<int> numMuon(const Pt &pt, const Eta &eta,
+                         const EventBatch &batch);
+
+std::vector<int> numTau(const EventBatch &batch);
+
+std::vector<int> numTau(const Pt &pt, const Eta &eta,
+                        const EventBatch &batch);
+
+std::vector<int> numNormalJet(const EventBatch &batch);
+
+std::vector<int> numNormalJet(const Pt &pt, const Eta &eta,
+                              const EventBatch &batch);
+
+std::vector<int> numBjet(const EventBatch &batch);
+
+std::vector<int> numBjet(const Pt &pt, const Eta &eta,
+                         const EventBatch &batch);
+
+std::vector<int> numAllJet(const EventBatch &batch);
+
+std::vector<int> numAllJet(const Pt &pt, const Eta &eta,
+                           const EventBatch &batch);
+
+// Missing transverse energy of each event, as missingET in lhco.h.
+std::vector<double> missingET(const EventBatch &batch);
+
+// Per-event mask, 1 for the events with missing ET above the threshold.
+Mask missingETAbove(const Pt &met, const EventBatch &batch);
+}  // namespace lhco
+
+#endif  // SRC_BATCH_SELECTION_H_
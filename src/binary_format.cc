@@ -0,0 +1,153 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#include "binary_format.h"
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include "byte_order.h"
+#include "object.h"
+#include "parser.h"
+
+namespace lhco {
+const char kBinaryMagic[] = "CLHCOBIN";
+const char kBinaryIndexMagic[] = "CLHCOIDX";
+
+bool isBinaryLHCO(const char *first, const char *last) {
+    return static_cast<std::size_t>(last - first) >= kBinaryHeaderSize &&
+           std::memcmp(first, kBinaryMagic, 8) == 0;
+}
+
+BinaryWriter::BinaryWriter(std::ostream *os) : os_(os) {
+    buffer_.append(kBinaryMagic, 8);
+    putU32(kBinaryVersion, &buffer_);
+    putU32(0, &buffer_);
+    os_->write(buffer_.data(), buffer_.size());
+    pos_ = buffer_.size();
+}
+
+void BinaryWriter::write(const RawEvent &ev) {
+    if (closed_ || ev.empty()) { return; }
+    const Header &header = ev.header();
+    const Objects &objs = ev.objects();
+    buffer_.clear();
+    putI32(header.event_number, &buffer_);
+    putI32(header.trigger_word, &buffer_);
+    putU32(static_cast<std::uint32_t>(objs.size()), &buffer_);
+    for (const auto &obj : objs) {
+        putI32(obj.typ, &buffer_);
+        putF64(obj.eta, &buffer_);
+        putF64(obj.phi, &buffer_);
+        putF64(obj.pt, &buffer_);
+        putF64(obj.jmass, &buffer_);
+        putI32(obj.ntrk, &buffer_);
+        putI32(obj.btag, &buffer_);
+        putF64(obj.hadem, &buffer_);
+    }
+    os_->write(buffer_.data(), buffer_.size());
+    offsets_.push_back(pos_);
+    pos_ += buffer_.size();
+}
+
+void BinaryWriter::close() {
+    if (closed_) { return; }
+    closed_ = true;
+    buffer_.clear();
+    for (const auto &offset : offsets_) { putU64(offset, &buffer_); }
+    putU64(offsets_.size(), &buffer_);
+    putU64(pos_, &buffer_);
+    buffer_.append(kBinaryIndexMagic, 8);
+    os_->write(buffer_.data(), buffer_.size());
+    os_->flush();
+}
+
+bool BinaryReader::open(const std::string &filename) {
+    valid_ = false;
+    index_ = nullptr;
+    num_events_ = 0;
+    if (!file_.open(filename)) { return false; }
+
+    const char *first = file_.begin();
+    const std::size_t size = file_.size();
+    if (!isBinaryLHCO(first, file_.end()) ||
+        size < kBinaryHeaderSize + kBinaryTrailerSize ||
+        getU32(first + 8) != kBinaryVersion) {
+        return false;
+    }
+    const char *trailer = file_.end() - kBinaryTrailerSize;
+    if (std::memcmp(trailer + 16, kBinaryIndexMagic, 8) != 0) {
+        return false;
+    }
+    const std::uint64_t num_events = getU64(trailer);
+    const std::uint64_t index_offset = getU64(trailer + 8);
+    if (index_offset < kBinaryHeaderSize || index_offset > size ||
+        num_events > (size - index_offset) / 8 ||
+        index_offset + 8 * num_events + kBinaryTrailerSize != size) {
+        return false;
+    }
+
+    index_ = first + index_offset;
+    num_events_ = static_cast<std::size_t>(num_events);
+    return valid_ = true;
+}
+
+RawEvent BinaryReader::raw_event(std::size_t i) const {
+    if (i >= num_events_) { return RawEvent(); }
+    // A corrupt offset or number of objects must not lead out of the events.
+    const std::uint64_t end =
+        static_cast<std::uint64_t>(index_ - file_.begin());
+    const std::uint64_t offset = getU64(index_ + 8 * i);
+    if (offset < kBinaryHeaderSize || offset > end ||
+        end - offset < kBinaryEventHeaderSize) {
+        return RawEvent();
+    }
+    const char *p = file_.begin() + offset;
+    const std::uint32_t num_objects = getU32(p + 8);
+    if ((end - offset - kBinaryEventHeaderSize) / kBinaryObjectSize <
+        num_objects) {
+        return RawEvent();
+    }
+    Header header(getI32(p), getI32(p + 4));
+    p += kBinaryEventHeaderSize;
+
+    Objects objs;
+    objs.reserve(num_objects);
+    for (std::uint32_t j = 0; j < num_objects; ++j, p += kBinaryObjectSize) {
+        objs.emplace_back(getI32(p), getF64(p + 4), getF64(p + 12),
+                          getF64(p + 20), getF64(p + 28), getI32(p + 36),
+                          getI32(p + 40), getF64(p + 44));
+    }
+    return {header, objs};
+}
+
+Event BinaryReader::event(std::size_t i) const {
+    return mkEvent(raw_event(i));
+}
+
+std::size_t convertToBinary(Reader *reader, std::ostream *os) {
+    BinaryWriter writer(os);
+    for (RawEvent ev = reader->next_raw_event(); !ev.empty();
+         ev = reader->next_raw_event()) {
+        writer.write(ev);
+    }
+    writer.close();
+    return writer.num_events();
+}
+
+std::size_t convertToBinary(std::istream *is, std::ostream *os) {
+    BinaryWriter writer(os);
+    for (RawEvent ev = parseRawEvent(is); !ev.empty();
+         ev = parseRawEvent(is)) {
+        writer.write(ev);
+    }
+    writer.close();
+    return writer.num_events();
+}
+
+std::size_t convertToText(const BinaryReader &reader, std::ostream *os) {
+    for (std::size_t i = 0; i < reader.size(); ++i) {
+        *os << reader.raw_event(i) << '\n';
+    }
+    return reader.size();
+}
+}  // namespace lhco
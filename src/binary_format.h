@@ -0,0 +1,94 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#ifndef SRC_BINARY_FORMAT_H_
+#define SRC_BINARY_FORMAT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "event.h"
+#include "mapped_file.h"
+#include "reader.h"
+
+namespace lhco {
+/*
+ * Binary LHCO files. All the numbers are little-endian.
+ *
+ *   file    = "CLHCOBIN" version:u32 reserved:u32 event* index trailer
+ *   event   = event_number:i32 trigger_word:i32 num_objects:u32 object*
+ *   object  = typ:i32 eta:f64 phi:f64 pt:f64 jmass:f64 ntrk:i32 btag:i32
+ *             hadem:f64
+ *   index   = offset:u64 (one for each event, from the start of the file)
+ *   trailer = num_events:u64 index_offset:u64 "CLHCOIDX"
+ */
+const std::uint32_t kBinaryVersion = 1;
+const std::size_t kBinaryHeaderSize = 16;
+const std::size_t kBinaryEventHeaderSize = 12;
+const std::size_t kBinaryObjectSize = 52;
+const std::size_t kBinaryTrailerSize = 24;
+
+// True if the buffer starts with the magic bytes of a binary LHCO file.
+bool isBinaryLHCO(const char *first, const char *last);
+
+class BinaryWriter {
+private:
+    std::ostream *os_;
+    std::uint64_t pos_ = 0;
+    std::vector<std::uint64_t> offsets_;
+    std::string buffer_;
+    bool closed_ = false;
+
+public:
+    // Writes the file header at once.
+    explicit BinaryWriter(std::ostream *os);
+    ~BinaryWriter() { close(); }
+    BinaryWriter(const BinaryWriter &) = delete;
+    BinaryWriter &operator=(const BinaryWriter &) = delete;
+
+    void write(const RawEvent &ev);
+    // Writes the index and the trailer. Nothing can be written after it.
+    void close();
+
+    std::size_t num_events() const { return offsets_.size(); }
+};
+
+/*
+ * Random access to the events of a memory-mapped binary LHCO file.
+ */
+class BinaryReader {
+private:
+    MappedFile file_;
+    const char *index_ = nullptr;
+    std::size_t num_events_ = 0;
+    bool valid_ = false;
+
+public:
+    BinaryReader() {}
+    explicit BinaryReader(const std::string &filename) { open(filename); }
+
+    // Returns false if the file cannot be read or is not a valid binary file.
+    bool open(const std::string &filename);
+    bool is_open() const { return valid_; }
+
+    std::size_t size() const { return num_events_; }
+    // An empty event if i is out of range or the event runs past the index.
+    RawEvent raw_event(std::size_t i) const;
+    Event event(std::size_t i) const;
+};
+
+// Converts text to binary, and returns the number of events written.
+std::size_t convertToBinary(Reader *reader, std::ostream *os);
+
+std::size_t convertToBinary(std::istream *is, std::ostream *os);
+
+/*
+ * Converts binary to text rendered with operator<<(std::ostream &, const
+ * RawEvent &), and returns the number of events written.
+ */
+std::size_t convertToText(const BinaryReader &reader, std::ostream *os);
+}  // namespace lhco
+
+#endif  // SRC_BINARY_FORMAT_H_
@@ -0,0 +1,62 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#ifndef SRC_BYTE_ORDER_H_
+#define SRC_BYTE_ORDER_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace lhco {
+// Little-endian encoding of fixed-width numbers, independent of the host.
+inline void putU32(std::uint32_t v, std::string *buf) {
+    for (int i = 0; i < 4; ++i) {
+        buf->push_back(static_cast<char>(v >> (8 * i)));
+    }
+}
+
+inline void putU64(std::uint64_t v, std::string *buf) {
+    for (int i = 0; i < 8; ++i) {
+        buf->push_back(static_cast<char>(v >> (8 * i)));
+    }
+}
+
+inline void putI32(int v, std::string *buf) {
+    putU32(static_cast<std::uint32_t>(v), buf);
+}
+
+inline void putF64(double v, std::string *buf) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &v, sizeof bits);
+    putU64(bits, buf);
+}
+
+inline std::uint32_t getU32(const char *p) {
+    std::uint32_t v = 0;
+    for (int i = 3; i >= 0; --i) {
+        v = (v << 8) | static_cast<unsigned char>(p[i]);
+    }
+    return v;
+}
+
+inline std::uint64_t getU64(const char *p) {
+    std::uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) {
+        v = (v << 8) | static_cast<unsigned char>(p[i]);
+    }
+    return v;
+}
+
+inline int getI32(const char *p) {
+    return static_cast<std::int32_t>(getU32(p));
+}
+
+inline double getF64(const char *p) {
+    const std::uint64_t bits = getU64(p);
+    double v;
+    std::memcpy(&v, &bits, sizeof v);
+    return v;
+}
+}  // namespace lhco
+
+#endif  // SRC_BYTE_ORDER_H_
@@ -0,0 +1,182 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#include "combinatorics.h"
+#include <cmath>
+#include <vector>
+
+namespace lhco {
+void Momenta::reserve(std::size_t n) {
+    e_.reserve(n);
+    px_.reserve(n);
+    py_.reserve(n);
+    pz_.reserve(n);
+    eta_.reserve(n);
+    phi_.reserve(n);
+}
+
+void Momenta::clear() {
+    e_.clear();
+    px_.clear();
+    py_.clear();
+    pz_.clear();
+    eta_.clear();
+    phi_.clear();
+}
+
+void Momenta::push_back(double e, double px, double py, double pz,
+                        double eta, double phi) {
+    e_.push_back(e);
+    px_.push_back(px);
+    py_.push_back(py);
+    pz_.push_back(pz);
+    eta_.push_back(eta);
+    phi_.push_back(phi);
+}
+
+// Invariant masses of (e, px, py, pz) plus each of b[first, b.size()). The
+// loop has no branches nor calls other than sqrt so that it can be
+// vectorized, and gives the same values as invariantMass in kinematics.cc.
+void fillMassRow(double e, double px, double py, double pz, const Momenta &b,
+                 std::size_t first, double *mass) {
+    const double *be = b.energy().data(), *bpx = b.px().data();
+    const double *bpy = b.py().data(), *bpz = b.pz().data();
+    for (std::size_t j = first; j < b.size(); ++j) {
+        const double se = e + be[j], spx = px + bpx[j];
+        const double spy = py + bpy[j], spz = pz + bpz[j];
+        const double m2 = se * se - spx * spx - spy * spy - spz * spz;
+        const double m = std::sqrt(std::fabs(m2));
+        mass[j] = m2 < 0 ? -m : m;
+    }
+}
+
+// Delta R of (eta, phi) and each of b[first, b.size()). The azimuthal angles
+// of LHCO objects are within one period, so a single correction of the
+// difference is enough to bring it into [-pi, pi).
+void fillDeltaRRow(double eta, double phi, const Momenta &b,
+                   std::size_t first, double *dr) {
+    const double pi = 3.14159265358979323846;
+    const double *beta = b.eta().data(), *bphi = b.phi().data();
+    for (std::size_t j = first; j < b.size(); ++j) {
+        const double deta = eta - beta[j];
+        double dphi = phi - bphi[j];
+        dphi = dphi >= pi ? dphi - 2.0 * pi : dphi;
+        dphi = dphi < -pi ? dphi + 2.0 * pi : dphi;
+        dr[j] = std::sqrt(deta * deta + dphi * dphi);
+    }
+}
+
+bool inMassWindow(double m, const CombinationCuts &cuts) {
+    return m >= cuts.mass_min && m <= cuts.mass_max;
+}
+
+bool inDeltaRWindow(double dr, const CombinationCuts &cuts) {
+    return dr >= cuts.dr_min && dr <= cuts.dr_max;
+}
+
+// For the pairs within one collection (same), only j > i are taken.
+void appendPairs(const Momenta &a, const Momenta &b, bool same,
+                 const CombinationCuts &cuts, ParticlePairs *pairs) {
+    std::vector<double> scratch(2 * b.size());
+    double *mass = scratch.data(), *dr = mass + b.size();
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        const std::size_t first = same ? i + 1 : 0;
+        fillDeltaRRow(a.eta()[i], a.phi()[i], b, first, dr);
+        fillMassRow(a.energy()[i], a.px()[i], a.py()[i], a.pz()[i], b, first,
+                    mass);
+        for (std::size_t j = first; j < b.size(); ++j) {
+            if (inDeltaRWindow(dr[j], cuts) && inMassWindow(mass[j], cuts)) {
+                pairs->push_back({i, j, mass[j], dr[j]});
+            }
+        }
+    }
+}
+
+ParticlePairs allPairs(const Momenta &a, const CombinationCuts &cuts) {
+    ParticlePairs pairs;
+    if (a.size() > 1) { pairs.reserve(a.size() * (a.size() - 1) / 2); }
+    appendPairs(a, a, true, cuts, &pairs);
+    return pairs;
+}
+
+ParticlePairs allPairs(const Momenta &a, const Momenta &b,
+                       const CombinationCuts &cuts) {
+    ParticlePairs pairs;
+    pairs.reserve(a.size() * b.size());
+    appendPairs(a, b, false, cuts, &pairs);
+    return pairs;
+}
+
+void appendTriplets(const Momenta &a, const Momenta &b, const Momenta &c,
+                    bool same, const CombinationCuts &cuts,
+                    ParticleTriplets *triplets) {
+    std::vector<double> scratch(3 * c.size() + 2 * b.size());
+    double *mass = scratch.data(), *dr_ik = mass + c.size();
+    double *dr_jk = dr_ik + c.size(), *dr_ij = dr_jk + c.size();
+    double *mass_ij = dr_ij + b.size();
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        const std::size_t first_j = same ? i + 1 : 0;
+        fillDeltaRRow(a.eta()[i], a.phi()[i], b, first_j, dr_ij);
+        fillMassRow(a.energy()[i], a.px()[i], a.py()[i], a.pz()[i], b,
+                    first_j, mass_ij);
+        if (!same) {
+            fillDeltaRRow(a.eta()[i], a.phi()[i], c, 0, dr_ik);
+        }
+
+        for (std::size_t j = first_j; j < b.size(); ++j) {
+            // The pair (i, j) prunes all the triplets containing it. Adding
+            // a physical four-momentum cannot lower the invariant mass, so a
+            // pair heavier than mass_max does as well.
+            if (!inDeltaRWindow(dr_ij[j], cuts) ||
+                mass_ij[j] > cuts.mass_max) {
+                continue;
+            }
+
+            const std::size_t first_k = same ? j + 1 : 0;
+            if (first_k >= c.size()) { continue; }
+            const double *ik = same ? dr_ij : dr_ik;
+            fillDeltaRRow(b.eta()[j], b.phi()[j], c, first_k, dr_jk);
+            fillMassRow(a.energy()[i] + b.energy()[j], a.px()[i] + b.px()[j],
+                        a.py()[i] + b.py()[j], a.pz()[i] + b.pz()[j], c,
+                        first_k, mass);
+            for (std::size_t k = first_k; k < c.size(); ++k) {
+                if (inDeltaRWindow(ik[k], cuts) &&
+                    inDeltaRWindow(dr_jk[k], cuts) &&
+                    inMassWindow(mass[k], cuts)) {
+                    triplets->push_back({i, j, k, mass[k]});
+                }
+            }
+        }
+    }
+}
+
+ParticleTriplets allTriplets(const Momenta &a, const CombinationCuts &cuts) {
+    ParticleTriplets triplets;
+    appendTriplets(a, a, a, true, cuts, &triplets);
+    return triplets;
+}
+
+ParticleTriplets allTriplets(const Momenta &a, const Momenta &b,
+                             const Momenta &c, const CombinationCuts &cuts) {
+    ParticleTriplets triplets;
+    appendTriplets(a, b, c, false, cuts, &triplets);
+    return triplets;
+}
+
+std::vector<double> massTable(const Momenta &a, const Momenta &b) {
+    std::vector<double> table(a.size() * b.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        fillMassRow(a.energy()[i], a.px()[i], a.py()[i], a.pz()[i], b, 0,
+                    table.data() + i * b.size());
+    }
+    return table;
+}
+
+std::vector<double> deltaRTable(const Momenta &a, const Momenta &b) {
+    std::vector<double> table(a.size() * b.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        fillDeltaRRow(a.eta()[i], a.phi()[i], b, 0,
+                      table.data() + i * b.size());
+    }
+    return table;
+}
+}  // namespace lhco
@@ -0,0 +1,102 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#ifndef SRC_COMBINATORICS_H_
+#define SRC_COMBINATORICS_H_
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace lhco {
+/*
+ * Four-momenta, eta, and phi of a collection in separate arrays, so that the
+ * loops over the combinations run over contiguous doubles. It can be built
+ * from any vector of particles with energy(), px(), py(), pz(), eta(), and
+ * phi(), e.g., Jets, Visibles, or FlatParticles.
+ */
+class Momenta {
+private:
+    std::vector<double> e_, px_, py_, pz_, eta_, phi_;
+
+public:
+    Momenta() {}
+    template <typename T>
+    explicit Momenta(const std::vector<T> &ps) {
+        reserve(ps.size());
+        for (const auto &p : ps) {
+            push_back(p.energy(), p.px(), p.py(), p.pz(), p.eta(), p.phi());
+        }
+    }
+
+    std::size_t size() const { return e_.size(); }
+    bool empty() const { return e_.empty(); }
+    void reserve(std::size_t n);
+    void clear();
+    void push_back(double e, double px, double py, double pz, double eta,
+                   double phi);
+
+    const std::vector<double> &energy() const { return e_; }
+    const std::vector<double> &px() const { return px_; }
+    const std::vector<double> &py() const { return py_; }
+    const std::vector<double> &pz() const { return pz_; }
+    const std::vector<double> &eta() const { return eta_; }
+    const std::vector<double> &phi() const { return phi_; }
+};
+
+/*
+ * Combinations are kept only if the invariant mass is in [mass_min, mass_max]
+ * and the Delta R of every pair of particles in them is in [dr_min, dr_max].
+ * The Delta R cut is applied first, and a pair failing it prunes all the
+ * triplets containing it. So does a pair heavier than mass_max.
+ */
+struct CombinationCuts {
+    double mass_min = 0.0;
+    double mass_max = std::numeric_limits<double>::infinity();
+    double dr_min = 0.0;
+    double dr_max = std::numeric_limits<double>::infinity();
+};
+
+// i and j are the positions in the first and second collections.
+struct ParticlePair {
+    std::size_t i;
+    std::size_t j;
+    double mass;
+    double delta_r;
+};
+
+using ParticlePairs = std::vector<ParticlePair>;
+
+struct ParticleTriplet {
+    std::size_t i;
+    std::size_t j;
+    std::size_t k;
+    double mass;
+};
+
+using ParticleTriplets = std::vector<ParticleTriplet>;
+
+// All the pairs (i, j) with i < j in one collection.
+ParticlePairs allPairs(const Momenta &a,
+                       const CombinationCuts &cuts = CombinationCuts());
+
+// All the pairs (i, j) of a[i] and b[j].
+ParticlePairs allPairs(const Momenta &a, const Momenta &b,
+                       const CombinationCuts &cuts = CombinationCuts());
+
+// All the triplets (i, j, k) with i < j < k in one collection.
+ParticleTriplets allTriplets(const Momenta &a,
+                             const CombinationCuts &cuts = CombinationCuts());
+
+// All the triplets (i, j, k) of a[i], b[j], and c[k].
+ParticleTriplets allTriplets(const Momenta &a, const Momenta &b,
+                             const Momenta &c,
+                             const CombinationCuts &cuts = CombinationCuts());
+
+// Invariant masses of a[i] and b[j] at i * b.size() + j.
+std::vector<double> massTable(const Momenta &a, const Momenta &b);
+
+// Delta R of a[i] and b[j] at i * b.size() + j.
+std::vector<double> deltaRTable(const Momenta &a, const Momenta &b);
+}  // namespace lhco
+
+#endif  // SRC_COMBINATORICS_H_
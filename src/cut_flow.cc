@@ -0,0 +1,273 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#include "cut_flow.h"
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace lhco {
+// The position of the collection of the kind in CutFlow::collections_.
+// ObjectKind::AllJet is counted as NormalJet plus Bjet.
+std::size_t collectionOf(ObjectKind kind) {
+    switch (kind) {
+    case ObjectKind::Photon:
+        return 0;
+    case ObjectKind::Electron:
+        return 1;
+    case ObjectKind::Muon:
+        return 2;
+    case ObjectKind::Tau:
+        return 3;
+    case ObjectKind::Bjet:
+        return 5;
+    default:
+        return 4;
+    }
+}
+
+bool compare(double x, Comparison cmp, double value) {
+    switch (cmp) {
+    case Comparison::Equal:
+        return x == value;
+    case Comparison::NotEqual:
+        return x != value;
+    case Comparison::Less:
+        return x < value;
+    case Comparison::LessEqual:
+        return x <= value;
+    case Comparison::Greater:
+        return x > value;
+    default:
+        return x >= value;
+    }
+}
+
+std::size_t CutFlow::add_threshold(std::size_t collection,
+                                   const Threshold &t) {
+    auto &thresholds = collections_[collection].thresholds;
+    for (std::size_t i = 0; i < thresholds.size(); ++i) {
+        if (thresholds[i].pt == t.pt && thresholds[i].eta == t.eta) {
+            return i;
+        }
+    }
+    thresholds.push_back(t);
+    collections_[collection].counts.push_back(0);
+    return thresholds.size() - 1;
+}
+
+CutFlow &CutFlow::add_count(const std::string &name, ObjectKind kind,
+                            bool all, const Threshold &t, Comparison cmp,
+                            int n) {
+    Cut cut;
+    cut.name = name;
+    cut.is_met = false;
+    cut.kind = kind;
+    cut.all = all;
+    cut.collection = collectionOf(kind);
+    cut.threshold = cut.bjet_threshold = 0;
+    if (!all) {
+        cut.threshold = add_threshold(cut.collection, t);
+        if (kind == ObjectKind::AllJet) {
+            cut.bjet_threshold = add_threshold(bjet_collection, t);
+        }
+    }
+    cut.cmp = cmp;
+    cut.value = n;
+    cuts_.push_back(cut);
+    passed_.push_back(0);
+    return *this;
+}
+
+CutFlow &CutFlow::add(const std::string &name, ObjectKind kind,
+                      Comparison cmp, int n) {
+    return add_count(name, kind, true, {0.0, 0.0}, cmp, n);
+}
+
+CutFlow &CutFlow::add(const std::string &name, ObjectKind kind,
+                      const Pt &pt, const Eta &eta, Comparison cmp, int n) {
+    return add_count(name, kind, false, {pt.value, eta.value}, cmp, n);
+}
+
+CutFlow &CutFlow::add_missing_et(const std::string &name, Comparison cmp,
+                                 double value) {
+    Cut cut;
+    cut.name = name;
+    cut.is_met = true;
+    cut.kind = ObjectKind::Photon;
+    cut.all = true;
+    cut.collection = cut.threshold = cut.bjet_threshold = 0;
+    cut.cmp = cmp;
+    cut.value = value;
+    cuts_.push_back(cut);
+    passed_.push_back(0);
+    return *this;
+}
+
+// Counts the objects for all the thresholds in a single walk. The counting
+// is branchless since the comparisons of pt and eta are hard to predict.
+template <typename T>
+void CutFlow::count_objects(const std::vector<T> &ps, Collection *c) {
+    const std::size_t n = c->thresholds.size();
+    const Threshold *th = c->thresholds.data();
+    int *counts = c->counts.data();
+    if (n == 1) {
+        int k = 0;
+        for (const auto &p : ps) {
+            k += (p.pt() > th->pt) & (std::abs(p.eta()) < th->eta);
+        }
+        *counts = k;
+        return;
+    }
+    for (std::size_t t = 0; t < n; ++t) { counts[t] = 0; }
+    for (const auto &p : ps) {
+        const double pt = p.pt(), abs_eta = std::abs(p.eta());
+        for (std::size_t t = 0; t < n; ++t) {
+            counts[t] += (pt > th[t].pt) & (abs_eta < th[t].eta);
+        }
+    }
+}
+
+void CutFlow::count(std::size_t collection, const Event &ev) {
+    Collection *c = &collections_[collection];
+    switch (collection) {
+    case 0:
+        count_objects(ev.photon(), c);
+        break;
+    case 1:
+        count_objects(ev.electron(), c);
+        break;
+    case 2:
+        count_objects(ev.muon(), c);
+        break;
+    case 3:
+        count_objects(ev.tau(), c);
+        break;
+    case 4:
+        count_objects(ev.jet(), c);
+        break;
+    default:
+        count_objects(ev.bjet(), c);
+    }
+}
+
+int sizeOf(std::size_t collection, const Event &ev) {
+    switch (collection) {
+    case 0:
+        return ev.photon().size();
+    case 1:
+        return ev.electron().size();
+    case 2:
+        return ev.muon().size();
+    case 3:
+        return ev.tau().size();
+    case 4:
+        return ev.jet().size();
+    default:
+        return ev.bjet().size();
+    }
+}
+
+bool CutFlow::pass(const Event &ev) {
+    // Bit i is set once collection i has been counted for this event.
+    unsigned counted = 0;
+    auto num_objects = [&](std::size_t c, bool all, std::size_t t) {
+        if (all) { return sizeOf(c, ev); }
+        if (!(counted & (1u << c))) {
+            count(c, ev);
+            counted |= 1u << c;
+        }
+        return collections_[c].counts[t];
+    };
+
+    ++num_events_;
+    for (std::size_t i = 0; i < cuts_.size(); ++i) {
+        const Cut &cut = cuts_[i];
+        double x;
+        if (cut.is_met) {
+            x = ev.met().pt();
+        } else {
+            int n = num_objects(cut.collection, cut.all, cut.threshold);
+            if (cut.kind == ObjectKind::AllJet) {
+                n += num_objects(bjet_collection, cut.all,
+                                 cut.bjet_threshold);
+            }
+            x = n;
+        }
+        if (!compare(x, cut.cmp, cut.value)) { return false; }
+        ++passed_[i];
+    }
+    return true;
+}
+
+double CutFlow::efficiency(std::size_t i) const {
+    const std::size_t before = i == 0 ? num_events_ : passed_[i - 1];
+    return before == 0 ? 0.0 : static_cast<double>(passed_[i]) / before;
+}
+
+double CutFlow::cumulative_efficiency(std::size_t i) const {
+    return num_events_ == 0 ? 0.0
+                            : static_cast<double>(passed_[i]) / num_events_;
+}
+
+void CutFlow::reset() {
+    num_events_ = 0;
+    for (auto &n : passed_) { n = 0; }
+}
+
+bool CutFlow::merge(const CutFlow &other) {
+    if (cuts_.size() != other.cuts_.size()) { return false; }
+    for (std::size_t i = 0; i < cuts_.size(); ++i) {
+        const Cut &a = cuts_[i], &b = other.cuts_[i];
+        if (a.name != b.name || a.is_met != b.is_met || a.kind != b.kind ||
+            a.all != b.all || a.cmp != b.cmp || a.value != b.value) {
+            return false;
+        }
+        if (a.is_met || a.all) { continue; }
+        // The same cut on other thresholds of pt and eta.
+        auto same = [&](std::size_t collection, std::size_t i, std::size_t j) {
+            const Threshold &ta = collections_[collection].thresholds[i];
+            const Threshold &tb = other.collections_[collection].thresholds[j];
+            return ta.pt == tb.pt && ta.eta == tb.eta;
+        };
+        if (a.collection != b.collection ||
+            !same(a.collection, a.threshold, b.threshold)) {
+            return false;
+        }
+        if (a.kind == ObjectKind::AllJet &&
+            !same(bjet_collection, a.bjet_threshold, b.bjet_threshold)) {
+            return false;
+        }
+    }
+    num_events_ += other.num_events_;
+    for (std::size_t i = 0; i < passed_.size(); ++i) {
+        passed_[i] += other.passed_[i];
+    }
+    return true;
+}
+
+void writeCutFlow(const CutFlow &cf, std::ostream *os) {
+    std::size_t width = 8;
+    for (std::size_t i = 0; i < cf.num_cuts(); ++i) {
+        if (cf.name(i).size() > width) { width = cf.name(i).size(); }
+    }
+    const auto flags = os->flags();
+    const std::streamsize precision = os->precision(4);
+    *os << std::left << std::setw(width) << "# cut" << std::right
+        << std::setw(14) << "events" << std::setw(12) << "eff."
+        << std::setw(12) << "cum. eff." << '\n';
+    *os << std::left << std::setw(width) << "(all)" << std::right
+        << std::setw(14) << cf.num_events() << '\n';
+    *os << std::fixed;
+    for (std::size_t i = 0; i < cf.num_cuts(); ++i) {
+        *os << std::left << std::setw(width) << cf.name(i) << std::right
+            << std::setw(14) << cf.passed(i) << std::setw(12)
+            << cf.efficiency(i) << std::setw(12)
+            << cf.cumulative_efficiency(i) << '\n';
+    }
+    os->flags(flags);
+    os->precision(precision);
+}
+}  // namespace lhco
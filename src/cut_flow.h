@@ -0,0 +1,116 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#ifndef SRC_CUT_FLOW_H_
+#define SRC_CUT_FLOW_H_
+
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "event.h"
+#include "kinematics.h"
+#include "object.h"
+
+namespace lhco {
+enum class Comparison {
+    Equal,
+    NotEqual,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual
+};
+
+/*
+ * Sequence of cuts on the number of objects in the collections of Event and
+ * on the missing ET, with the number of events passing each of them.
+ *
+ * The cuts are applied in the order they were added, and the first failure
+ * rejects the event. Each collection is walked at most once per event: the
+ * first cut on it counts the objects for all the (Pt, Eta) thresholds used by
+ * any cut on it, and the later cuts read the counts. The object counts are
+ * the same as the ones of numPhoton, ..., numAllJet in lhco.h.
+ *
+ * pass() updates the counters, so use one CutFlow per thread and merge them.
+ */
+class CutFlow {
+private:
+    // Photon, Electron, Muon, Tau, NormalJet, and Bjet.
+    static constexpr std::size_t num_collections = 6;
+    static constexpr std::size_t bjet_collection = 5;
+
+    struct Threshold {
+        double pt;
+        double eta;
+    };
+
+    struct Collection {
+        std::vector<Threshold> thresholds;
+        std::vector<int> counts;
+    };
+
+    struct Cut {
+        std::string name;
+        bool is_met;
+        ObjectKind kind;
+        bool all;  // No cut on pt and eta.
+        std::size_t collection;
+        // Positions in the thresholds of the collections: the second is
+        // for the b-jets of ObjectKind::AllJet.
+        std::size_t threshold;
+        std::size_t bjet_threshold;
+        Comparison cmp;
+        double value;
+    };
+
+    std::array<Collection, num_collections> collections_;
+    std::vector<Cut> cuts_;
+    std::size_t num_events_ = 0;
+    std::vector<std::size_t> passed_;
+
+    template <typename T>
+    static void count_objects(const std::vector<T> &ps, Collection *c);
+
+    std::size_t add_threshold(std::size_t collection, const Threshold &t);
+    CutFlow &add_count(const std::string &name, ObjectKind kind, bool all,
+                       const Threshold &t, Comparison cmp, int n);
+    // Counts the objects of the collection for all the thresholds on it.
+    void count(std::size_t collection, const Event &ev);
+
+public:
+    CutFlow() {}
+
+    // Requires the number of objects of the kind to satisfy cmp n.
+    CutFlow &add(const std::string &name, ObjectKind kind, Comparison cmp,
+                 int n);
+    // The same, counting only the objects with pt > pt and |eta| < eta.
+    CutFlow &add(const std::string &name, ObjectKind kind, const Pt &pt,
+                 const Eta &eta, Comparison cmp, int n);
+    // Requires missingET(ev) to satisfy cmp value.
+    CutFlow &add_missing_et(const std::string &name, Comparison cmp,
+                            double value);
+
+    // True if the event passes all the cuts.
+    bool pass(const Event &ev);
+
+    std::size_t num_cuts() const { return cuts_.size(); }
+    const std::string &name(std::size_t i) const { return cuts_[i].name; }
+    std::size_t num_events() const { return num_events_; }
+    // The number of events passing the cuts up to i.
+    std::size_t passed(std::size_t i) const { return passed_[i]; }
+    // passed(i) over the number of events passing the cuts before i.
+    double efficiency(std::size_t i) const;
+    // passed(i) over num_events().
+    double cumulative_efficiency(std::size_t i) const;
+
+    void reset();
+    // Adds the counters of the other. False if its cuts are not the same.
+    bool merge(const CutFlow &other);
+};
+
+// Writes one line per cut: the name, the passed events, and the efficiencies.
+void writeCutFlow(const CutFlow &cf, std::ostream *os);
+}  // namespace lhco
+
+#endif  // SRC_CUT_FLOW_H_
@@ -0,0 +1,145 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#include "dataset.h"
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif  // HAVE_CONFIG_H
+#ifdef HAVE_GLOB_H
+#include <glob.h>
+#endif  // HAVE_GLOB_H
+#ifdef HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif  // HAVE_SYS_STAT_H
+#include "input_stream.h"
+#include "parser.h"
+#include "reader.h"
+
+namespace lhco {
+std::size_t forEachEventInFile(
+    const std::string &filename,
+    const std::function<void(const Event &)> &visit) {
+    std::size_t num_events = 0;
+    EventReader events(filename);
+    if (events.is_open()) {
+        for (const Event &ev : events) {
+            visit(ev);
+            ++num_events;
+        }
+        return num_events;
+    }
+
+    // Reader does not open gzip-compressed files.
+    InputStream is(filename);
+    if (!is.is_open()) {
+        throw std::runtime_error("cannot open file: " + filename);
+    }
+    for (Event ev = parseEvent(&is); !ev.empty(); ev = parseEvent(&is)) {
+        visit(ev);
+        ++num_events;
+    }
+    if (is.error()) {
+        throw std::runtime_error("corrupt or truncated file: " + filename);
+    }
+    return num_events;
+}
+
+std::vector<std::size_t> Dataset::largest_first() const {
+    std::vector<std::size_t> order(files_.size());
+    for (std::size_t i = 0; i < order.size(); ++i) { order[i] = i; }
+    std::stable_sort(order.begin(), order.end(),
+                     [this](std::size_t a, std::size_t b) {
+                         return sizes_[a] > sizes_[b];
+                     });
+    return order;
+}
+
+std::vector<std::vector<std::size_t>> Dataset::split(
+    unsigned num_workers) const {
+    if (num_workers == 0) { num_workers = defaultNumThreads(); }
+    num_workers = static_cast<unsigned>(
+        std::min<std::size_t>(num_workers, files_.size()));
+    std::vector<std::vector<std::size_t>> shares(num_workers);
+    std::vector<std::uint64_t> loads(num_workers, 0);
+    for (const auto f : largest_first()) {
+        const std::size_t w =
+            std::min_element(loads.begin(), loads.end()) - loads.begin();
+        shares[w].push_back(f);
+        loads[w] += sizes_[f];
+    }
+    for (auto &share : shares) { std::sort(share.begin(), share.end()); }
+    return shares;
+}
+
+bool Dataset::add(const std::string &filename) {
+#ifdef HAVE_SYS_STAT_H
+    struct stat st;
+    if (stat(filename.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+        return false;
+    }
+#endif  // HAVE_SYS_STAT_H
+    std::ifstream is(filename, std::ios::binary | std::ios::ate);
+    if (!is) { return false; }
+    // A directory can be opened, but has no position.
+    const std::streamoff size = is.tellg();
+    if (size < 0) { return false; }
+    files_.push_back(filename);
+    sizes_.push_back(static_cast<std::uint64_t>(size));
+    return true;
+}
+
+std::size_t Dataset::add_glob(const std::string &pattern) {
+    std::size_t num_added = 0;
+#ifdef HAVE_GLOB_H
+    glob_t matches;
+    if (glob(pattern.c_str(), 0, nullptr, &matches) == 0) {
+        for (std::size_t i = 0; i < matches.gl_pathc; ++i) {
+            if (add(matches.gl_pathv[i])) { ++num_added; }
+        }
+    }
+    globfree(&matches);
+#else
+    // Without glob(3), the pattern can only be a file name.
+    if (add(pattern)) { ++num_added; }
+#endif  // HAVE_GLOB_H
+    return num_added;
+}
+
+std::size_t Dataset::add_list(const std::string &list_filename) {
+    std::ifstream is(list_filename);
+    std::size_t num_added = 0;
+    std::string line;
+    while (std::getline(is, line)) {
+        const std::size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') { continue; }
+        const std::size_t last = line.find_last_not_of(" \t\r");
+        if (add(line.substr(first, last - first + 1))) { ++num_added; }
+    }
+    return num_added;
+}
+
+std::uint64_t Dataset::total_size() const {
+    std::uint64_t total = 0;
+    for (const auto &s : sizes_) { total += s; }
+    return total;
+}
+
+std::vector<std::size_t> Dataset::count_events(unsigned num_threads) const {
+    const std::vector<std::size_t> order = largest_first();
+    std::vector<std::size_t> counts(files_.size(), 0);
+    parallelFor(order.size(), num_threads, [&](std::size_t i) {
+        const std::size_t f = order[i];
+        Reader reader(files_[f]);
+        if (reader.is_open()) {
+            counts[f] = reader.count_events();
+        } else {
+            counts[f] = forEachEventInFile(files_[f], [](const Event &) {});
+        }
+    });
+    return counts;
+}
+}  // namespace lhco
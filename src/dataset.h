@@ -0,0 +1,116 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#ifndef SRC_DATASET_H_
+#define SRC_DATASET_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "event.h"
+#include "parallel.h"
+
+namespace lhco {
+/*
+ * Calls visit(ev) for every event of the file, read as parseEvent reads it.
+ * Plain files are memory-mapped and gzip-compressed ones go through
+ * InputStream. Returns the number of events. Throws std::runtime_error if
+ * the file cannot be opened, or if a compressed file turns out to be corrupt
+ * or truncated after visiting the events read before the error.
+ */
+std::size_t forEachEventInFile(const std::string &filename,
+                               const std::function<void(const Event &)> &visit);
+
+/*
+ * A sample made of many LHCO files, processed on several threads. The files
+ * are shared out among the threads by size before starting, and the results
+ * of the threads are merged in a fixed order, so that for a given number of
+ * threads the outcome does not depend on which file finishes first.
+ */
+class Dataset {
+private:
+    std::vector<std::string> files_;
+    std::vector<std::uint64_t> sizes_;
+
+    // The indices of the files from the largest to the smallest.
+    std::vector<std::size_t> largest_first() const;
+    /*
+     * Shares the files out among at most num_workers workers (all hardware
+     * threads if zero), each next largest file going to the worker with the
+     * fewest bytes so far. Each share is in the order of the files.
+     */
+    std::vector<std::vector<std::size_t>> split(unsigned num_workers) const;
+
+public:
+    Dataset() {}
+    explicit Dataset(const std::vector<std::string> &files) {
+        for (const auto &f : files) { add(f); }
+    }
+
+    // False if it is not a regular file or cannot be opened.
+    bool add(const std::string &filename);
+    // Adds the files matching the pattern in sorted order.
+    std::size_t add_glob(const std::string &pattern);
+    /*
+     * Adds the files listed in a text file, one per line. Blank lines and
+     * lines starting with '#' are skipped. Returns the number of files
+     * added, or zero if the list cannot be read.
+     */
+    std::size_t add_list(const std::string &list_filename);
+
+    std::size_t size() const { return files_.size(); }
+    bool empty() const { return files_.empty(); }
+    const std::string &file(std::size_t i) const { return files_[i]; }
+    std::uint64_t file_size(std::size_t i) const { return sizes_[i]; }
+    std::uint64_t total_size() const;
+
+    /*
+     * Each of num_threads threads (all hardware threads if zero) gets a copy
+     * of init, and visit(ev, &result) is called for the events of its files
+     * in order. The results of the threads are then combined by
+     * merge(&total, result) in the order of the threads, starting from init,
+     * which should therefore be empty. Throws as forEachEventInFile does, once
+     * all the threads have finished.
+     */
+    template <typename Result, typename Visit, typename Merge>
+    Result process_with(const Result &init, Visit visit, Merge merge,
+                        unsigned num_threads = 0) const;
+
+    // The same, merging with total.merge(result) as for histograms and
+    // cut flows.
+    template <typename Result, typename Visit>
+    Result process(const Result &init, Visit visit,
+                   unsigned num_threads = 0) const {
+        return process_with(
+            init, visit,
+            [](Result *total, const Result &r) { total->merge(r); },
+            num_threads);
+    }
+
+    // The number of events in each file. Throws as forEachEventInFile does.
+    std::vector<std::size_t> count_events(unsigned num_threads = 0) const;
+};
+
+template <typename Result, typename Visit, typename Merge>
+Result Dataset::process_with(const Result &init, Visit visit, Merge merge,
+                             unsigned num_threads) const {
+    const std::vector<std::vector<std::size_t>> shares = split(num_threads);
+    std::vector<Result> results(shares.size(), init);
+    parallelFor(shares.size(), static_cast<unsigned>(shares.size()),
+                [&](std::size_t w) {
+                    Result *result = &results[w];
+                    for (const auto f : shares[w]) {
+                        forEachEventInFile(files_[f], [&](const Event &ev) {
+                            visit(ev, result);
+                        });
+                    }
+                });
+
+    Result total = init;
+    for (const auto &r : results) { merge(&total, r); }
+    return total;
+}
+}  // namespace lhco
+
+#endif  // SRC_DATASET_H_
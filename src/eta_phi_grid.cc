@@ -0,0 +1,118 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#include "eta_phi_grid.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace lhco {
+const double kPi = 3.14159265358979323846;
+// Upper limit on the number of cells along each axis.
+const std::size_t kMaxGridCells = 1024;
+
+std::size_t EtaPhiGrid::eta_cell(double eta) const {
+    const double d = (eta - eta_min_) / cell_size_;
+    if (!(d > 0.0)) { return 0; }
+    if (!(d < num_eta_)) { return num_eta_ - 1; }
+    return static_cast<std::size_t>(d);
+}
+
+std::size_t EtaPhiGrid::phi_cell(double phi) const {
+    const double d = (deltaPhi(phi, 0.0) + kPi) / phi_width_;
+    if (!(d > 0.0)) { return 0; }
+    if (!(d < num_phi_)) { return num_phi_ - 1; }
+    return static_cast<std::size_t>(d);
+}
+
+void EtaPhiGrid::index() {
+    const std::size_t n = eta_.size();
+    num_phi_ = static_cast<std::size_t>(2.0 * kPi / cell_size_);
+    num_phi_ = std::max<std::size_t>(1, std::min(num_phi_, kMaxGridCells));
+    phi_width_ = 2.0 * kPi / num_phi_;
+
+    num_eta_ = 0;
+    if (n > 0) {
+        const auto range = std::minmax_element(eta_.begin(), eta_.end());
+        eta_min_ = *range.first;
+        const double extent = (*range.second - eta_min_) / cell_size_;
+        num_eta_ = extent < kMaxGridCells
+                       ? static_cast<std::size_t>(extent) + 1
+                       : kMaxGridCells;
+    }
+
+    // Counting sort of the objects by cell, keeping their order in a cell.
+    const std::size_t num_cells = num_eta_ * num_phi_;
+    cell_start_.assign(num_cells + 1, 0);
+    cell_of_.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        cell_of_[i] = eta_cell(eta_[i]) * num_phi_ + phi_cell(phi_[i]);
+        ++cell_start_[cell_of_[i] + 1];
+    }
+    for (std::size_t c = 0; c < num_cells; ++c) {
+        cell_start_[c + 1] += cell_start_[c];
+    }
+    cell_items_.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        cell_items_[cell_start_[cell_of_[i]]++] = i;
+    }
+    // The loop above moved every start to the end of its cell.
+    for (std::size_t c = num_cells; c > 0; --c) {
+        cell_start_[c] = cell_start_[c - 1];
+    }
+    cell_start_[0] = 0;
+}
+
+template <typename Visit>
+bool EtaPhiGrid::for_each_near(double eta, double phi, double r,
+                               Visit visit) const {
+    if (eta_.empty() || !(r > 0.0)) { return true; }
+    const std::size_t first_eta = eta_cell(eta - r);
+    const std::size_t last_eta = eta_cell(eta + r);
+
+    // No object is within any distance of an infinite or NaN angle.
+    const double phi_pos = (deltaPhi(phi, 0.0) + kPi) / phi_width_;
+    if (std::isnan(phi_pos)) { return true; }
+
+    // One more cell on each side in phi absorbs the rounding at the wrap.
+    const long num_phi = static_cast<long>(num_phi_);
+    const double span = r / phi_width_;
+    long first_phi = 0, last_phi = num_phi - 1;
+    if (span + 2.0 < num_phi_) {
+        first_phi = static_cast<long>(std::floor(phi_pos - span)) - 1;
+        last_phi = static_cast<long>(std::floor(phi_pos + span)) + 1;
+        if (last_phi - first_phi + 1 >= num_phi) {
+            first_phi = 0;
+            last_phi = num_phi - 1;
+        }
+    }
+
+    for (std::size_t ie = first_eta; ie <= last_eta; ++ie) {
+        for (long k = first_phi; k <= last_phi; ++k) {
+            const long ip = ((k % num_phi) + num_phi) % num_phi;
+            const std::size_t c = ie * num_phi_ + ip;
+            for (std::size_t s = cell_start_[c]; s < cell_start_[c + 1]; ++s) {
+                const std::size_t i = cell_items_[s];
+                if (deltaR(eta, phi, eta_[i], phi_[i]) < r && !visit(i)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void EtaPhiGrid::within(double eta, double phi, double r,
+                        std::vector<std::size_t> *out) const {
+    out->clear();
+    for_each_near(eta, phi, r, [out](std::size_t i) {
+        out->push_back(i);
+        return true;
+    });
+    std::sort(out->begin(), out->end());
+}
+
+bool EtaPhiGrid::any_within(double eta, double phi, double r) const {
+    return !for_each_near(eta, phi, r, [](std::size_t) { return false; });
+}
+}  // namespace lhco
@@ -0,0 +1,169 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#ifndef SRC_ETA_PHI_GRID_H_
+#define SRC_ETA_PHI_GRID_H_
+
+#include <cstddef>
+#include <vector>
+#include "kinematics.h"
+
+namespace lhco {
+/*
+ * Objects binned in eta and phi, so that finding those within Delta R < r of
+ * a point looks only at the cells around it. The cells are cell_size wide
+ * in eta and at least as wide in phi, where they wrap around. A cell size
+ * close to the radius of the queries works best.
+ *
+ * The grid can be built from any vector of particles with eta() and phi(),
+ * and build() reuses the storage of the previous event.
+ */
+class EtaPhiGrid {
+private:
+    double cell_size_;
+    double eta_min_ = 0.0;
+    double phi_width_ = 0.0;
+    std::size_t num_eta_ = 0;
+    std::size_t num_phi_ = 0;
+    std::vector<double> eta_, phi_;
+    // The objects of cell c are cell_items_[cell_start_[c]] up to
+    // cell_items_[cell_start_[c + 1]].
+    std::vector<std::size_t> cell_start_;
+    std::vector<std::size_t> cell_items_;
+    std::vector<std::size_t> cell_of_;
+
+    std::size_t eta_cell(double eta) const;
+    std::size_t phi_cell(double phi) const;
+    void index();
+    /*
+     * Calls visit(i) for the objects with Delta R < r, cell by cell, until
+     * it returns false. Returns false if it was stopped.
+     */
+    template <typename Visit>
+    bool for_each_near(double eta, double phi, double r, Visit visit) const;
+
+public:
+    explicit EtaPhiGrid(double cell_size = 0.4)
+        : cell_size_(cell_size > 0.0 ? cell_size : 0.4) {}
+
+    template <typename T>
+    void build(const std::vector<T> &ps) {
+        eta_.clear();
+        phi_.clear();
+        for (const auto &p : ps) {
+            eta_.push_back(p.eta());
+            phi_.push_back(p.phi());
+        }
+        index();
+    }
+    void build(const std::vector<double> &eta, const std::vector<double> &phi) {
+        eta_ = eta;
+        phi_ = phi;
+        index();
+    }
+
+    std::size_t size() const { return eta_.size(); }
+    bool empty() const { return eta_.empty(); }
+    double cell_size() const { return cell_size_; }
+
+    /*
+     * Replaces *out with the positions of the objects with Delta R < r from
+     * (eta, phi) in increasing order.
+     */
+    void within(double eta, double phi, double r,
+                std::vector<std::size_t> *out) const;
+    // True if any object has Delta R < r from (eta, phi).
+    bool any_within(double eta, double phi, double r) const;
+};
+
+/*
+ * Below this number of pairs, the functions below compare every pair
+ * directly, which is faster than building a grid. Both ways select exactly
+ * the same objects.
+ */
+const std::size_t kGridMinPairs = 4096;
+
+/*
+ * The positions of the objects of ps that have no object of others within
+ * Delta R < r, e.g., the jets that are not electrons.
+ */
+template <typename T, typename U>
+std::vector<std::size_t> isolatedFrom(const std::vector<T> &ps,
+                                      const std::vector<U> &others, double r,
+                                      EtaPhiGrid *grid = nullptr) {
+    std::vector<std::size_t> kept;
+    if (ps.size() * others.size() < kGridMinPairs) {
+        for (std::size_t i = 0; i < ps.size(); ++i) {
+            bool overlap = false;
+            for (const auto &o : others) {
+                if (deltaR(ps[i].eta(), ps[i].phi(), o.eta(), o.phi()) < r) {
+                    overlap = true;
+                    break;
+                }
+            }
+            if (!overlap) { kept.push_back(i); }
+        }
+        return kept;
+    }
+
+    EtaPhiGrid own_grid(r);
+    if (grid == nullptr) { grid = &own_grid; }
+    grid->build(others);
+    for (std::size_t i = 0; i < ps.size(); ++i) {
+        if (!grid->any_within(ps[i].eta(), ps[i].phi(), r)) {
+            kept.push_back(i);
+        }
+    }
+    return kept;
+}
+
+// The same, returning the objects themselves.
+template <typename T, typename U>
+std::vector<T> removeOverlaps(const std::vector<T> &ps,
+                              const std::vector<U> &others, double r,
+                              EtaPhiGrid *grid = nullptr) {
+    std::vector<T> kept;
+    for (const auto i : isolatedFrom(ps, others, r, grid)) {
+        kept.push_back(ps[i]);
+    }
+    return kept;
+}
+
+/*
+ * For each object of ps, the sum of the pt of the objects of others within
+ * 0 < Delta R < r. Objects at exactly the same position are left out, so
+ * that ps and others can be the same collection.
+ */
+template <typename T, typename U>
+std::vector<double> isolationSums(const std::vector<T> &ps,
+                                  const std::vector<U> &others, double r,
+                                  EtaPhiGrid *grid = nullptr) {
+    std::vector<double> sums(ps.size(), 0.0);
+    if (ps.size() * others.size() < kGridMinPairs) {
+        for (std::size_t i = 0; i < ps.size(); ++i) {
+            for (const auto &o : others) {
+                const double dr =
+                    deltaR(ps[i].eta(), ps[i].phi(), o.eta(), o.phi());
+                if (dr > 0.0 && dr < r) { sums[i] += o.pt(); }
+            }
+        }
+        return sums;
+    }
+
+    EtaPhiGrid own_grid(r);
+    if (grid == nullptr) { grid = &own_grid; }
+    grid->build(others);
+    std::vector<std::size_t> near;
+    for (std::size_t i = 0; i < ps.size(); ++i) {
+        grid->within(ps[i].eta(), ps[i].phi(), r, &near);
+        for (const auto j : near) {
+            const auto &o = others[j];
+            if (deltaR(ps[i].eta(), ps[i].phi(), o.eta(), o.phi()) > 0.0) {
+                sums[i] += o.pt();
+            }
+        }
+    }
+    return sums;
+}
+}  // namespace lhco
+
+#endif  // SRC_ETA_PHI_GRID_H_
@@ -2,8 +2,15 @@
 
 #include "event.h"
 #include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <iomanip>
+#include <limits>
+#include <utility>
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif  // HAVE_CONFIG_H
+#include "stats.h"
 
 namespace lhco {
 std::string RawEvent::show() const {
@@ -15,6 +22,7 @@ std::string RawEvent::show() const {
 }
 
 std::ostream &operator<<(std::ostream &os, const RawEvent &ev) {
+    LHCO_STAT_TIMER(Output);
     os << std::setw(3) << 0 << ev.header_ << '\n';
     auto ss = os.precision();
     int counter = 1;
@@ -43,23 +51,98 @@ std::string showAll(const std::vector<T> &ps) {
 
 std::string Event::show() const {
     std::string str = "Event {";
-    str += showAll(photons_) + showAll(electrons_) + showAll(muons_);
-    str += showAll(taus_) + showAll(jets_) + showAll(bjets_);
+    str += showAll(photon()) + showAll(electron()) + showAll(muon());
+    str += showAll(tau()) + showAll(jet()) + showAll(bjet());
     str += met_.show() + "}";
     return str;
 }
 
+/*
+ * Sorts the particles by pt in descending order, or only the leading ones if
+ * there are more than num_leading. Most generators write the objects in
+ * order already. Short collections are sorted by insertion, which takes
+ * linear time on them, and the longer ones are checked first.
+ */
 template <typename T>
-void sortByPt(std::vector<T> *ps) {
-    if (!ps->empty()) { std::sort(ps->begin(), ps->end(), std::greater<T>()); }
+void sortByPt(std::vector<T> *ps, std::size_t num_leading) {
+    const std::size_t n = ps->size();
+    if (n <= 16) {
+        for (std::size_t i = 1; i < n; ++i) {
+            if ((*ps)[i - 1].pt() >= (*ps)[i].pt()) { continue; }
+            T p = std::move((*ps)[i]);
+            std::size_t j = i;
+            for (; j > 0 && (*ps)[j - 1].pt() < p.pt(); --j) {
+                (*ps)[j] = std::move((*ps)[j - 1]);
+            }
+            (*ps)[j] = std::move(p);
+        }
+        return;
+    }
+    if (std::is_sorted(ps->begin(), ps->end(), std::greater<T>())) { return; }
+    if (num_leading < n) {
+        std::partial_sort(ps->begin(), ps->begin() + num_leading, ps->end(),
+                          std::greater<T>());
+    } else {
+        std::sort(ps->begin(), ps->end(), std::greater<T>());
+    }
+}
+
+void Event::clear() {
+    status_ = EventStatus::Empty;
+    unsorted_ = 0;
+    photons_.clear();
+    electrons_.clear();
+    muons_.clear();
+    taus_.clear();
+    jets_.clear();
+    bjets_.clear();
+    met_ = Met();
+}
+
+void Event::sort_collection(unsigned i) {
+    LHCO_STAT_TIMER(Sort);
+    const std::size_t all = std::numeric_limits<std::size_t>::max();
+    switch (i) {
+    case 0:
+        sortByPt(&photons_, all);
+        break;
+    case 1:
+        sortByPt(&electrons_, all);
+        break;
+    case 2:
+        sortByPt(&muons_, all);
+        break;
+    case 3:
+        sortByPt(&taus_, all);
+        break;
+    case 4:
+        sortByPt(&jets_, all);
+        break;
+    default:
+        sortByPt(&bjets_, all);
+    }
+    unsorted_ &= ~(1u << i);
+}
+
+void Event::ensure_sorted() {
+    for (unsigned i = 0; i < 6; ++i) { sort_if_unsorted(i); }
 }
 
 void Event::sort_particles() {
-    sortByPt(&photons_);
-    sortByPt(&electrons_);
-    sortByPt(&muons_);
-    sortByPt(&taus_);
-    sortByPt(&jets_);
-    sortByPt(&bjets_);
+    if (sort_mode_ == SortMode::Lazy) {
+        unsorted_ = (1u << 6) - 1;
+        return;
+    }
+    LHCO_STAT_TIMER(Sort);
+    const std::size_t k = sort_mode_ == SortMode::Leading
+                              ? num_leading_
+                              : std::numeric_limits<std::size_t>::max();
+    sortByPt(&photons_, k);
+    sortByPt(&electrons_, k);
+    sortByPt(&muons_, k);
+    sortByPt(&taus_, k);
+    sortByPt(&jets_, k);
+    sortByPt(&bjets_, k);
+    unsorted_ = 0;
 }
 }  // namespace lhco
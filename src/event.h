@@ -3,8 +3,10 @@
 #ifndef SRC_EVENT_H_
 #define SRC_EVENT_H_
 
+#include <cstddef>
 #include <ostream>
 #include <string>
+#include <utility>
 #include <vector>
 #include "object.h"
 #include "particle.h"
@@ -28,8 +30,20 @@ public:
         header_ = header;
         objects_ = objects;
     }
-    Header header() const { return header_; }
-    Objects objects() const { return objects_; }
+    void set_event(const Header &header, Objects &&objects) {
+        status_ = EventStatus::Fill;
+        header_ = header;
+        objects_ = std::move(objects);
+    }
+    // Empties the event but keeps the storage of the objects for reuse.
+    void clear() {
+        status_ = EventStatus::Empty;
+        objects_.clear();
+    }
+    void set_header(const Header &header) { header_ = header; }
+    void add_object(const Object &obj) { objects_.push_back(obj); }
+    const Header &header() const { return header_; }
+    const Objects &objects() const { return objects_; }
     bool empty() const { return status_ == EventStatus::Empty; }
     void operator()(const EventStatus &s) { status_ = s; }
 
@@ -37,9 +51,27 @@ public:
     friend std::ostream &operator<<(std::ostream &os, const RawEvent &ev);
 };
 
+/*
+ * How Event::sort_particles orders the collections by pt. All sorts them
+ * completely. Leading puts only the leading num_leading objects in order at
+ * the front, and leaves the rest in no particular order. Lazy leaves them as
+ * they are, and sorts each collection completely when it is first read
+ * through sorted_photon(), ..., sorted_bjet(), or all of them at
+ * ensure_sorted(). These are not const, so that an Event shared as const
+ * between threads is never modified; photon(), ..., bjet() return the
+ * collections as they are. In every mode, the collections that are already
+ * in order are detected in linear time and left as they are.
+ */
+enum class SortMode { All, Leading, Lazy };
+
 class Event {
 private:
     EventStatus status_;
+    SortMode sort_mode_ = SortMode::All;
+    std::size_t num_leading_ = 4;
+    Kinematics kinematics_ = Kinematics::Eager;
+    // The collections still to be sorted in the Lazy mode, one bit each.
+    unsigned unsorted_ = 0;
 
     std::vector<Photon> photons_;
     std::vector<Electron> electrons_;
@@ -49,51 +81,57 @@ private:
     std::vector<Bjet> bjets_;
     Met met_;
 
+    void sort_collection(unsigned i);
+    void sort_if_unsorted(unsigned i) {
+        if (unsorted_ & (1u << i)) { sort_collection(i); }
+    }
+
 public:
     explicit Event(EventStatus s = EventStatus::Empty) : status_(s) {}
 
-    std::vector<Photon> photon() const { return photons_; }
+    const std::vector<Photon> &photon() const { return photons_; }
     void add_photon(const Object &obj) {
         status_ = EventStatus::Fill;
-        Photon photon(Pt(obj.pt), Eta(obj.eta), Phi(obj.phi), Mass(obj.jmass));
+        Photon photon(Pt(obj.pt), Eta(obj.eta), Phi(obj.phi), Mass(obj.jmass),
+                      kinematics_);
         photons_.push_back(photon);
     }
-    std::vector<Electron> electron() const { return electrons_; }
+    const std::vector<Electron> &electron() const { return electrons_; }
     void add_electron(const Object &obj) {
         status_ = EventStatus::Fill;
         Electron elec(Pt(obj.pt), Eta(obj.eta), Phi(obj.phi), Mass(obj.jmass),
-                      obj.ntrk);
+                      obj.ntrk, kinematics_);
         electrons_.push_back(elec);
     }
-    std::vector<Muon> muon() const { return muons_; }
+    const std::vector<Muon> &muon() const { return muons_; }
     void add_muon(const Object &obj) {
         status_ = EventStatus::Fill;
         Muon muon(Pt(obj.pt), Eta(obj.eta), Phi(obj.phi), Mass(obj.jmass),
-                  obj.ntrk, obj.hadem);
+                  obj.ntrk, obj.hadem, kinematics_);
         muons_.push_back(muon);
     }
-    std::vector<Tau> tau() const { return taus_; }
+    const std::vector<Tau> &tau() const { return taus_; }
     void add_tau(const Object &obj) {
         status_ = EventStatus::Fill;
         Tau tau(Pt(obj.pt), Eta(obj.eta), Phi(obj.phi), Mass(obj.jmass),
-                obj.ntrk);
+                obj.ntrk, kinematics_);
         taus_.push_back(tau);
     }
-    std::vector<Jet> jet() const { return jets_; }
+    const std::vector<Jet> &jet() const { return jets_; }
     void add_jet(const Object &obj) {
         status_ = EventStatus::Fill;
         Jet jet(Pt(obj.pt), Eta(obj.eta), Phi(obj.phi), Mass(obj.jmass),
-                obj.ntrk);
+                obj.ntrk, kinematics_);
         jets_.push_back(jet);
     }
-    std::vector<Bjet> bjet() const { return bjets_; }
+    const std::vector<Bjet> &bjet() const { return bjets_; }
     void add_bjet(const Object &obj) {
         status_ = EventStatus::Fill;
         Bjet bjet(Pt(obj.pt), Eta(obj.eta), Phi(obj.phi), Mass(obj.jmass),
-                  obj.ntrk, obj.btag);
+                  obj.ntrk, obj.btag, kinematics_);
         bjets_.push_back(bjet);
     }
-    Met met() const { return met_; }
+    const Met &met() const { return met_; }
     void set_met(const Object &obj) {
         status_ = EventStatus::Fill;
         met_ = Met(Pt(obj.pt), Phi(obj.phi));
@@ -102,6 +140,51 @@ public:
     void operator()(const EventStatus &s) { status_ = s; }
     void sort_particles();
 
+    // The collections in order of pt, also in the Lazy mode.
+    const std::vector<Photon> &sorted_photon() {
+        sort_if_unsorted(0);
+        return photons_;
+    }
+    const std::vector<Electron> &sorted_electron() {
+        sort_if_unsorted(1);
+        return electrons_;
+    }
+    const std::vector<Muon> &sorted_muon() {
+        sort_if_unsorted(2);
+        return muons_;
+    }
+    const std::vector<Tau> &sorted_tau() {
+        sort_if_unsorted(3);
+        return taus_;
+    }
+    const std::vector<Jet> &sorted_jet() {
+        sort_if_unsorted(4);
+        return jets_;
+    }
+    const std::vector<Bjet> &sorted_bjet() {
+        sort_if_unsorted(5);
+        return bjets_;
+    }
+    // Sorts the collections that the Lazy mode has left unsorted.
+    void ensure_sorted();
+    // False if some collections are left unsorted by the Lazy mode.
+    bool sorted() const { return unsorted_ == 0; }
+
+    void set_sort_mode(SortMode mode, std::size_t num_leading = 4) {
+        sort_mode_ = mode;
+        num_leading_ = num_leading;
+    }
+    SortMode sort_mode() const { return sort_mode_; }
+    std::size_t num_leading() const { return num_leading_; }
+    // How the particles added from now on compute their momenta.
+    void set_kinematics(Kinematics kinematics) { kinematics_ = kinematics; }
+    Kinematics kinematics() const { return kinematics_; }
+    /*
+     * Empties the event but keeps the storage of the particles for reuse.
+     * The sort mode and the kinematics are kept as well.
+     */
+    void clear();
+
     std::string show() const;
 };
 }  // namespace lhco
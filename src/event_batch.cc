@@ -0,0 +1,85 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#include "event_batch.h"
+#include <cstddef>
+#include "parser.h"
+
+namespace lhco {
+Object EventView::object(std::size_t i) const {
+    return {typ(i), eta(i),  phi(i),  pt(i),
+            jmass(i), ntrk(i), btag(i), hadem(i)};
+}
+
+RawEvent EventView::raw_event() const {
+    Objects objs;
+    objs.reserve(size());
+    for (std::size_t i = 0; i < size(); ++i) { objs.push_back(object(i)); }
+    return {header(), objs};
+}
+
+void EventBatch::reserve(std::size_t num_events, std::size_t num_objects) {
+    event_number_.reserve(num_events);
+    trigger_word_.reserve(num_events);
+    offsets_.reserve(num_events + 1);
+    typ_.reserve(num_objects);
+    eta_.reserve(num_objects);
+    phi_.reserve(num_objects);
+    pt_.reserve(num_objects);
+    jmass_.reserve(num_objects);
+    ntrk_.reserve(num_objects);
+    btag_.reserve(num_objects);
+    hadem_.reserve(num_objects);
+}
+
+void EventBatch::clear() {
+    event_number_.clear();
+    trigger_word_.clear();
+    offsets_.assign(1, 0);
+    typ_.clear();
+    eta_.clear();
+    phi_.clear();
+    pt_.clear();
+    jmass_.clear();
+    ntrk_.clear();
+    btag_.clear();
+    hadem_.clear();
+}
+
+void EventBatch::push_back(const Header &header, const Objects &objects) {
+    event_number_.push_back(header.event_number);
+    trigger_word_.push_back(header.trigger_word);
+    for (const auto &obj : objects) {
+        typ_.push_back(obj.typ);
+        eta_.push_back(obj.eta);
+        phi_.push_back(obj.phi);
+        pt_.push_back(obj.pt);
+        jmass_.push_back(obj.jmass);
+        ntrk_.push_back(obj.ntrk);
+        btag_.push_back(obj.btag);
+        hadem_.push_back(obj.hadem);
+    }
+    offsets_.push_back(typ_.size());
+}
+
+std::size_t fillBatch(Reader *reader, std::size_t max_events,
+                      EventBatch *batch) {
+    std::size_t n = 0;
+    for (; n < max_events; ++n) {
+        RawEvent ev = reader->next_raw_event();
+        if (ev.empty()) { break; }
+        batch->push_back(ev);
+    }
+    return n;
+}
+
+std::size_t fillBatch(std::istream *is, std::size_t max_events,
+                      EventBatch *batch) {
+    std::size_t n = 0;
+    for (; n < max_events; ++n) {
+        RawEvent ev = parseRawEvent(is);
+        if (ev.empty()) { break; }
+        batch->push_back(ev);
+    }
+    return n;
+}
+}  // namespace lhco
@@ -0,0 +1,152 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#ifndef SRC_EVENT_BATCH_H_
+#define SRC_EVENT_BATCH_H_
+
+#include <cstddef>
+#include <istream>
+#include <vector>
+#include "event.h"
+#include "object.h"
+#include "reader.h"
+
+namespace lhco {
+class EventBatch;
+
+/*
+ * Read-only view of one event in an EventBatch. It holds only indices, so
+ * it is cheap to copy, but it is invalidated when the batch is modified.
+ */
+class EventView {
+private:
+    const EventBatch *batch_;
+    std::size_t index_;
+    std::size_t first_;
+    std::size_t last_;
+
+public:
+    EventView(const EventBatch *batch, std::size_t index);
+
+    Header header() const;
+    std::size_t size() const { return last_ - first_; }
+    // Position of the first object of the event in the batch arrays.
+    std::size_t offset() const { return first_; }
+
+    int typ(std::size_t i) const;
+    double eta(std::size_t i) const;
+    double phi(std::size_t i) const;
+    double pt(std::size_t i) const;
+    double jmass(std::size_t i) const;
+    int ntrk(std::size_t i) const;
+    int btag(std::size_t i) const;
+    double hadem(std::size_t i) const;
+
+    Object object(std::size_t i) const;
+    RawEvent raw_event() const;
+};
+
+/*
+ * Many events stored as contiguous arrays, one for each field of Object
+ * (structure of arrays). The objects of event i are at the positions
+ * [offsets()[i], offsets()[i + 1]) of every array.
+ */
+class EventBatch {
+private:
+    std::vector<int> event_number_;
+    std::vector<int> trigger_word_;
+    std::vector<std::size_t> offsets_;
+
+    std::vector<int> typ_;
+    std::vector<double> eta_;
+    std::vector<double> phi_;
+    std::vector<double> pt_;
+    std::vector<double> jmass_;
+    std::vector<int> ntrk_;
+    std::vector<int> btag_;
+    std::vector<double> hadem_;
+
+public:
+    EventBatch() : offsets_(1, 0) {}
+
+    std::size_t size() const { return event_number_.size(); }
+    std::size_t num_objects() const { return typ_.size(); }
+    bool empty() const { return event_number_.empty(); }
+
+    void reserve(std::size_t num_events, std::size_t num_objects);
+    void clear();
+    void push_back(const Header &header, const Objects &objects);
+    void push_back(const RawEvent &ev) {
+        if (!ev.empty()) { push_back(ev.header(), ev.objects()); }
+    }
+
+    EventView operator[](std::size_t i) const { return EventView(this, i); }
+
+    const std::vector<int> &event_number() const { return event_number_; }
+    const std::vector<int> &trigger_word() const { return trigger_word_; }
+    const std::vector<std::size_t> &offsets() const { return offsets_; }
+
+    const std::vector<int> &typ() const { return typ_; }
+    const std::vector<double> &eta() const { return eta_; }
+    const std::vector<double> &phi() const { return phi_; }
+    const std::vector<double> &pt() const { return pt_; }
+    const std::vector<double> &jmass() const { return jmass_; }
+    const std::vector<int> &ntrk() const { return ntrk_; }
+    const std::vector<int> &btag() const { return btag_; }
+    const std::vector<double> &hadem() const { return hadem_; }
+};
+
+inline EventView::EventView(const EventBatch *batch, std::size_t index)
+    : batch_(batch),
+      index_(index),
+      first_(batch->offsets()[index]),
+      last_(batch->offsets()[index + 1]) {}
+
+inline Header EventView::header() const {
+    return {batch_->event_number()[index_], batch_->trigger_word()[index_]};
+}
+
+inline int EventView::typ(std::size_t i) const {
+    return batch_->typ()[first_ + i];
+}
+
+inline double EventView::eta(std::size_t i) const {
+    return batch_->eta()[first_ + i];
+}
+
+inline double EventView::phi(std::size_t i) const {
+    return batch_->phi()[first_ + i];
+}
+
+inline double EventView::pt(std::size_t i) const {
+    return batch_->pt()[first_ + i];
+}
+
+inline double EventView::jmass(std::size_t i) const {
+    return batch_->jmass()[first_ + i];
+}
+
+inline int EventView::ntrk(std::size_t i) const {
+    return batch_->ntrk()[first_ + i];
+}
+
+inline int EventView::btag(std::size_t i) const {
+    return batch_->btag()[first_ + i];
+}
+
+inline double EventView::hadem(std::size_t i) const {
+    return batch_->hadem()[first_ + i];
+}
+
+/*
+ * Appends up to max_events events to the batch, and returns the number of
+ * events appended. A return value smaller than max_events means that the
+ * input is over.
+ */
+std::size_t fillBatch(Reader *reader, std::size_t max_events,
+                      EventBatch *batch);
+
+std::size_t fillBatch(std::istream *is, std::size_t max_events,
+                      EventBatch *batch);
+}  // namespace lhco
+
+#endif  // SRC_EVENT_BATCH_H_
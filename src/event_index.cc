@@ -0,0 +1,167 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#include "event_index.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "byte_order.h"
+#include "scanner.h"
+
+namespace lhco {
+const char kIndexMagic[] = "CLHCOSIX";
+const std::size_t kIndexHeaderSize = 32;
+const std::size_t kIndexEntrySize = 12;
+// The number of bytes hashed at each end of the file.
+const std::size_t kFingerprintBytes = 4096;
+
+std::uint64_t fileFingerprint(const char *first, const char *last) {
+    // FNV-1a
+    std::uint64_t hash = 14695981039346656037ULL;
+    auto add = [&hash](const char *p, const char *end) {
+        for (; p < end; ++p) {
+            hash ^= static_cast<unsigned char>(*p);
+            hash *= 1099511628211ULL;
+        }
+    };
+    const std::size_t size = last - first;
+    if (size <= 2 * kFingerprintBytes) {
+        add(first, last);
+    } else {
+        add(first, first + kFingerprintBytes);
+        add(last - kFingerprintBytes, last);
+    }
+    return hash;
+}
+
+void EventIndex::sort_by_number() {
+    by_number_.clear();
+    by_number_.reserve(entries_.size());
+    for (std::size_t i = 0; i < entries_.size(); ++i) {
+        by_number_.emplace_back(entries_[i].event_number, i);
+    }
+    std::sort(by_number_.begin(), by_number_.end());
+}
+
+std::size_t EventIndex::find(int event_number) const {
+    auto it = std::lower_bound(by_number_.begin(), by_number_.end(),
+                               std::make_pair(event_number, std::size_t(0)));
+    if (it == by_number_.end() || it->first != event_number) {
+        return entries_.size();
+    }
+    return it->second;
+}
+
+bool EventIndex::save(const std::string &filename) const {
+    std::string buffer(kIndexMagic, 8);
+    putU64(file_size_, &buffer);
+    putU64(fingerprint_, &buffer);
+    putU64(entries_.size(), &buffer);
+    for (const auto &entry : entries_) {
+        putU64(entry.offset, &buffer);
+        putI32(entry.event_number, &buffer);
+    }
+    std::ofstream os(filename, std::ios::binary);
+    os.write(buffer.data(), buffer.size());
+    return static_cast<bool>(os);
+}
+
+bool EventIndex::load(const std::string &filename, std::uint64_t file_size,
+                      std::uint64_t fingerprint) {
+    std::ifstream is(filename, std::ios::binary);
+    if (!is) { return false; }
+    const std::string buffer((std::istreambuf_iterator<char>(is)),
+                             std::istreambuf_iterator<char>());
+    if (buffer.size() < kIndexHeaderSize ||
+        std::memcmp(buffer.data(), kIndexMagic, 8) != 0 ||
+        getU64(buffer.data() + 8) != file_size ||
+        getU64(buffer.data() + 16) != fingerprint) {
+        return false;
+    }
+    const std::uint64_t num_events = getU64(buffer.data() + 24);
+    if ((buffer.size() - kIndexHeaderSize) / kIndexEntrySize != num_events ||
+        (buffer.size() - kIndexHeaderSize) % kIndexEntrySize != 0) {
+        return false;
+    }
+
+    std::vector<IndexEntry> entries;
+    entries.reserve(num_events);
+    const char *p = buffer.data() + kIndexHeaderSize;
+    for (std::uint64_t i = 0; i < num_events; ++i, p += kIndexEntrySize) {
+        entries.emplace_back(getU64(p), getI32(p + 8));
+    }
+    *this = EventIndex(file_size, fingerprint, entries);
+    return true;
+}
+
+EventIndex buildIndex(const char *first, const char *last) {
+    std::vector<IndexEntry> entries;
+    const char *event_begin = first;
+    int event_number = 0;
+    for (const char *pos = first; pos < last;) {
+        const char *line = pos;
+        const char *eol = endOfLine(line, last);
+        pos = eol == last ? last : eol + 1;
+        if (isCommentLine(line, eol)) { continue; }
+
+        Scanner in(line, eol);
+        int first_digit = 0, second_digit = 0;
+        in >> first_digit >> second_digit;
+        if (first_digit == 0) {  // line for event header
+            event_number = second_digit;
+        } else if (second_digit == 6) {  // line for missing energy
+            entries.emplace_back(event_begin - first, event_number);
+            event_begin = pos;
+            event_number = 0;
+        } else if (second_digit > 6) {  // undefined line
+            break;
+        }
+    }
+    return EventIndex(last - first, fileFingerprint(first, last), entries);
+}
+
+EventIndex loadOrBuildIndex(const std::string &filename, const Reader &reader,
+                            bool save) {
+    EventIndex index;
+    const std::string sidecar = indexFilename(filename);
+    const char *first = reader.data();
+    const char *last = first + reader.size();
+    if (index.load(sidecar, reader.size(), fileFingerprint(first, last))) {
+        return index;
+    }
+    index = buildIndex(first, last);
+    if (save) { index.save(sidecar); }
+    return index;
+}
+
+bool seekEvent(const EventIndex &index, std::size_t ordinal, Reader *reader) {
+    if (ordinal >= index.size()) { return false; }
+    const std::uint64_t offset = index[ordinal].offset;
+    if (offset >= reader->size()) { return false; }
+
+    const char *last = reader->data() + reader->size();
+    for (const char *line = reader->data() + offset; line < last;) {
+        const char *eol = endOfLine(line, last);
+        const char *p = line;
+        while (p < eol && isSpace(*p)) { ++p; }
+        if (p < eol && !isCommentLine(line, eol)) {
+            Scanner in(line, eol);
+            int first_digit = -1;
+            in >> first_digit;
+            if (in.fail() || first_digit != 0) { return false; }
+            reader->seek(offset);
+            return true;
+        }
+        line = eol == last ? last : eol + 1;
+    }
+    return false;
+}
+
+bool seekEventNumber(const EventIndex &index, int event_number,
+                     Reader *reader) {
+    return seekEvent(index, index.find(event_number), reader);
+}
+}  // namespace lhco
@@ -0,0 +1,95 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#ifndef SRC_EVENT_INDEX_H_
+#define SRC_EVENT_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "reader.h"
+
+namespace lhco {
+struct IndexEntry {
+    // Byte offset at which parseRawEvent starts reading the event.
+    std::uint64_t offset = 0;
+    int event_number = 0;
+
+    IndexEntry() {}
+    IndexEntry(std::uint64_t _offset, int _evnum)
+        : offset(_offset), event_number(_evnum) {}
+};
+
+/*
+ * Byte offsets of the events of a text LHCO file, by ordinal and by
+ * Header::event_number. It is kept next to the file as a sidecar.
+ */
+class EventIndex {
+private:
+    std::uint64_t file_size_ = 0;
+    std::uint64_t fingerprint_ = 0;
+    std::vector<IndexEntry> entries_;
+    std::vector<std::pair<int, std::size_t>> by_number_;
+
+    void sort_by_number();
+
+public:
+    EventIndex() {}
+    EventIndex(std::uint64_t file_size, std::uint64_t fingerprint,
+               const std::vector<IndexEntry> &entries)
+        : file_size_(file_size), fingerprint_(fingerprint), entries_(entries) {
+        sort_by_number();
+    }
+
+    std::size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+    std::uint64_t file_size() const { return file_size_; }
+    std::uint64_t fingerprint() const { return fingerprint_; }
+    const IndexEntry &operator[](std::size_t i) const { return entries_[i]; }
+
+    // Ordinal of the first event with the event number, or size() if none.
+    std::size_t find(int event_number) const;
+
+    bool save(const std::string &filename) const;
+    /*
+     * Returns false if the sidecar cannot be read, or if it was built for a
+     * file of another size or fingerprint.
+     */
+    bool load(const std::string &filename, std::uint64_t file_size,
+              std::uint64_t fingerprint);
+};
+
+/*
+ * A hash of the first and the last few kilobytes of [first, last), so that
+ * a file regenerated with the same size does not reuse a stale index.
+ */
+std::uint64_t fileFingerprint(const char *first, const char *last);
+
+// Scans [first, last) once, reading only the first two fields of each line.
+EventIndex buildIndex(const char *first, const char *last);
+
+// The name of the sidecar index of an LHCO file.
+inline std::string indexFilename(const std::string &filename) {
+    return filename + ".idx";
+}
+
+/*
+ * Loads the sidecar index of the file opened by the reader, or builds it
+ * (and saves it if save is true) when it is missing or out of date.
+ */
+EventIndex loadOrBuildIndex(const std::string &filename, const Reader &reader,
+                            bool save = true);
+
+/*
+ * Moves the reader to the event of the given ordinal. Returns false if the
+ * first line there, after comments and blank lines, is not an event header.
+ */
+bool seekEvent(const EventIndex &index, std::size_t ordinal, Reader *reader);
+
+// Moves the reader to the first event with the given event number.
+bool seekEventNumber(const EventIndex &index, int event_number,
+                     Reader *reader);
+}  // namespace lhco
+
+#endif  // SRC_EVENT_INDEX_H_
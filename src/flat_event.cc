@@ -0,0 +1,63 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#include "flat_event.h"
+#include <algorithm>
+#include <type_traits>
+
+namespace lhco {
+static_assert(std::is_trivially_copyable<FlatParticle>::value,
+              "FlatParticle must be trivially copyable");
+
+void FlatEvent::add(const Object &obj) {
+    status_ = EventStatus::Fill;
+    switch (obj.typ) {
+    case 0:  // photon
+        photons_.emplace_back(ParticleKind::Photon, obj);
+        break;
+    case 1:  // electron
+        electrons_.emplace_back(ParticleKind::Electron, obj);
+        break;
+    case 2:  // muon
+        muons_.emplace_back(ParticleKind::Muon, obj);
+        break;
+    case 3:  // tau
+        taus_.emplace_back(ParticleKind::Tau, obj);
+        break;
+    case 4:
+        if (obj.btag > 0.5) {  // b-jet
+            bjets_.emplace_back(ParticleKind::Bjet, obj);
+        } else {  // normal jet
+            jets_.emplace_back(ParticleKind::Jet, obj);
+        }
+        break;
+    default:  // missing energy
+        met_ = FlatParticle(ParticleKind::Met, obj);
+        break;
+    }
+}
+
+void sortFlatByPt(FlatParticles *ps) {
+    std::sort(ps->begin(), ps->end(),
+              [](const FlatParticle &lhs, const FlatParticle &rhs) {
+                  return lhs.pt() > rhs.pt();
+              });
+}
+
+void FlatEvent::sort_particles() {
+    sortFlatByPt(&photons_);
+    sortFlatByPt(&electrons_);
+    sortFlatByPt(&muons_);
+    sortFlatByPt(&taus_);
+    sortFlatByPt(&jets_);
+    sortFlatByPt(&bjets_);
+}
+
+FlatEvent mkFlatEvent(const RawEvent &raw_ev) {
+    FlatEvent ev;
+    if (!raw_ev.empty()) {
+        for (const auto &obj : raw_ev.objects()) { ev.add(obj); }
+        ev.sort_particles();
+    }
+    return ev;
+}
+}  // namespace lhco
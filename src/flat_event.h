@@ -0,0 +1,199 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#ifndef SRC_FLAT_EVENT_H_
+#define SRC_FLAT_EVENT_H_
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "event.h"
+#include "kinematics.h"
+#include "object.h"
+
+namespace lhco {
+enum class ParticleKind : std::uint8_t {
+    Photon,
+    Electron,
+    Muon,
+    Tau,
+    Jet,
+    Bjet,
+    Met
+};
+
+/*
+ * Non-virtual, trivially copyable counterpart of the classes in particle.h.
+ * The kind of the particle is stored as a tag, and the accessors give the
+ * same values as the ones of Photon, Electron, Muon, Tau, Jet, Bjet, and Met.
+ * The Cartesian components are computed when they are asked for.
+ */
+class FlatParticle {
+private:
+    double pt_;
+    double eta_;
+    double phi_;
+    double mass_;
+    double hadem_;
+    std::int32_t ntrk_;
+    std::int8_t btag_;
+    ParticleKind kind_;
+
+public:
+    FlatParticle() = default;
+    FlatParticle(ParticleKind kind, const Object &obj)
+        : pt_(obj.pt),
+          eta_(obj.eta),
+          phi_(obj.phi),
+          mass_(obj.jmass),
+          hadem_(obj.hadem),
+          ntrk_(obj.ntrk),
+          btag_(obj.btag < 1.5 ? 1 : 2),
+          kind_(kind) {
+        if (kind == ParticleKind::Met) { eta_ = mass_ = hadem_ = 0.0; }
+    }
+
+    ParticleKind kind() const { return kind_; }
+
+    double pt() const { return pt_; }
+    double eta() const { return eta_; }
+    double phi() const { return phi_; }
+    double mass() const { return mass_; }
+
+    double px() const { return pt_ * std::cos(phi_); }
+    double py() const { return pt_ * std::sin(phi_); }
+    double pz() const { return pt_ * std::sinh(eta_); }
+    double energy() const {
+        const double pz = this->pz();
+        const double m2 = mass_ > 0.0 ? mass_ * mass_ : 0.0;
+        return std::sqrt(pt_ * pt_ + pz * pz + m2);
+    }
+
+    int charge() const {
+        switch (kind_) {
+        case ParticleKind::Electron:
+        case ParticleKind::Muon:
+            return ntrk_ > 0 ? 1 : (ntrk_ < 0 ? -1 : 0);
+        case ParticleKind::Tau:
+            return ntrk_ > 0 ? 1 : -1;
+        default:
+            return 0;
+        }
+    }
+    // Zero unless it is a b-jet.
+    int btag() const { return kind_ == ParticleKind::Bjet ? btag_ : 0; }
+    // Zero unless it is a tau.
+    int prong() const {
+        return kind_ == ParticleKind::Tau ? (ntrk_ < 2 ? 1 : 3) : 0;
+    }
+    int num_track() const { return ntrk_; }
+    // Zero unless it is a muon.
+    double ptiso() const {
+        return kind_ == ParticleKind::Muon ? std::trunc(hadem_) : 0.0;
+    }
+    double etrat() const {
+        return kind_ == ParticleKind::Muon ? hadem_ - std::trunc(hadem_) : 0.0;
+    }
+
+    friend bool operator<(const FlatParticle &lhs, const FlatParticle &rhs) {
+        return lhs.pt() < rhs.pt();
+    }
+    friend bool operator>(const FlatParticle &lhs, const FlatParticle &rhs) {
+        return rhs < lhs;
+    }
+};
+
+using FlatParticles = std::vector<FlatParticle>;
+
+/*
+ * Event whose collections are contiguous arrays of FlatParticle. It holds
+ * the same particles in the same order as Event.
+ */
+class FlatEvent {
+private:
+    EventStatus status_;
+    FlatParticles photons_;
+    FlatParticles electrons_;
+    FlatParticles muons_;
+    FlatParticles taus_;
+    FlatParticles jets_;
+    FlatParticles bjets_;
+    FlatParticle met_;
+
+public:
+    explicit FlatEvent(EventStatus s = EventStatus::Empty)
+        : status_(s), met_(ParticleKind::Met, Object()) {}
+
+    const FlatParticles &photon() const { return photons_; }
+    const FlatParticles &electron() const { return electrons_; }
+    const FlatParticles &muon() const { return muons_; }
+    const FlatParticles &tau() const { return taus_; }
+    const FlatParticles &jet() const { return jets_; }
+    const FlatParticles &bjet() const { return bjets_; }
+    const FlatParticle &met() const { return met_; }
+
+    // Puts the object into its collection as parseEvent does.
+    void add(const Object &obj);
+    bool empty() const { return status_ == EventStatus::Empty; }
+    void operator()(const EventStatus &s) { status_ = s; }
+    void sort_particles();
+};
+
+FlatEvent mkFlatEvent(const RawEvent &raw_ev);
+
+inline int numOfParticles(const Pt &pt, const Eta &eta,
+                          const FlatParticles &ps) {
+    int count = 0;
+    for (const auto &p : ps) {
+        count += p.pt() > pt.value && std::abs(p.eta()) < eta.value;
+    }
+    return count;
+}
+
+inline int numPhoton(const FlatEvent &ev) { return ev.photon().size(); }
+
+inline int numPhoton(const Pt &pt, const Eta &eta, const FlatEvent &ev) {
+    return numOfParticles(pt, eta, ev.photon());
+}
+
+inline int numElectron(const FlatEvent &ev) { return ev.electron().size(); }
+
+inline int numElectron(const Pt &pt, const Eta &eta, const FlatEvent &ev) {
+    return numOfParticles(pt, eta, ev.electron());
+}
+
+inline int numMuon(const FlatEvent &ev) { return ev.muon().size(); }
+
+inline int numMuon(const Pt &pt, const Eta &eta, const FlatEvent &ev) {
+    return numOfParticles(pt, eta, ev.muon());
+}
+
+inline int numTau(const FlatEvent &ev) { return ev.tau().size(); }
+
+inline int numTau(const Pt &pt, const Eta &eta, const FlatEvent &ev) {
+    return numOfParticles(pt, eta, ev.tau());
+}
+
+inline int numNormalJet(const FlatEvent &ev) { return ev.jet().size(); }
+
+inline int numNormalJet(const Pt &pt, const Eta &eta, const FlatEvent &ev) {
+    return numOfParticles(pt, eta, ev.jet());
+}
+
+inline int numBjet(const FlatEvent &ev) { return ev.bjet().size(); }
+
+inline int numBjet(const Pt &pt, const Eta &eta, const FlatEvent &ev) {
+    return numOfParticles(pt, eta, ev.bjet());
+}
+
+inline int numAllJet(const FlatEvent &ev) {
+    return numNormalJet(ev) + numBjet(ev);
+}
+
+inline int numAllJet(const Pt &pt, const Eta &eta, const FlatEvent &ev) {
+    return numNormalJet(pt, eta, ev) + numBjet(pt, eta, ev);
+}
+
+inline double missingET(const FlatEvent &ev) { return ev.met().pt(); }
+}  // namespace lhco
+
+#endif  // SRC_FLAT_EVENT_H_
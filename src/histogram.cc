@@ -0,0 +1,157 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#include "histogram.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+namespace lhco {
+Binning::Binning(std::size_t num_bins, double low, double high) {
+    if (num_bins == 0 || !(low < high)) { return; }
+    edges_.reserve(num_bins + 1);
+    for (std::size_t i = 0; i < num_bins; ++i) {
+        edges_.push_back(low + (high - low) * i / num_bins);
+    }
+    edges_.push_back(high);
+}
+
+Binning::Binning(const std::vector<double> &edges) : uniform_(false) {
+    if (edges.size() < 2) { return; }
+    for (std::size_t i = 1; i < edges.size(); ++i) {
+        if (!(edges[i - 1] < edges[i])) { return; }
+    }
+    edges_ = edges;
+}
+
+std::size_t Binning::find(double x) const {
+    const std::size_t n = num_bins();
+    if (n == 0 || !(x >= edges_.front())) { return 0; }
+    if (x >= edges_.back()) { return n + 1; }
+    if (uniform_) {
+        // The same as TAxis::FindBin of ROOT.
+        const double low = edges_.front(), high = edges_.back();
+        const std::size_t i =
+            1 + static_cast<std::size_t>(n * (x - low) / (high - low));
+        return i > n ? n : i;
+    }
+    return std::upper_bound(edges_.begin(), edges_.end(), x) - edges_.begin();
+}
+
+double sumOf(const std::vector<double> &v, std::size_t first,
+             std::size_t last) {
+    double sum = 0.0;
+    for (std::size_t i = first; i < last; ++i) { sum += v[i]; }
+    return sum;
+}
+
+void addTo(const std::vector<double> &from, std::vector<double> *to) {
+    for (std::size_t i = 0; i < from.size(); ++i) { (*to)[i] += from[i]; }
+}
+
+double Histogram1D::error(std::size_t i) const { return std::sqrt(sumw2_[i]); }
+
+double Histogram1D::integral() const {
+    return sumOf(sumw_, 1, num_bins() + 1);
+}
+
+void Histogram1D::reset() {
+    std::fill(sumw_.begin(), sumw_.end(), 0.0);
+    std::fill(sumw2_.begin(), sumw2_.end(), 0.0);
+    entries_ = 0;
+}
+
+bool Histogram1D::merge(const Histogram1D &other) {
+    if (binning_ != other.binning_) { return false; }
+    addTo(other.sumw_, &sumw_);
+    addTo(other.sumw2_, &sumw2_);
+    entries_ += other.entries_;
+    return true;
+}
+
+double Histogram2D::error(std::size_t ix, std::size_t iy) const {
+    return std::sqrt(sumw2_[index(ix, iy)]);
+}
+
+double Histogram2D::integral() const {
+    double sum = 0.0;
+    for (std::size_t iy = 1; iy <= ybinning_.num_bins(); ++iy) {
+        sum += sumOf(sumw_, index(1, iy), index(xbinning_.num_bins() + 1, iy));
+    }
+    return sum;
+}
+
+void Histogram2D::reset() {
+    std::fill(sumw_.begin(), sumw_.end(), 0.0);
+    std::fill(sumw2_.begin(), sumw2_.end(), 0.0);
+    entries_ = 0;
+}
+
+bool Histogram2D::merge(const Histogram2D &other) {
+    if (xbinning_ != other.xbinning_ || ybinning_ != other.ybinning_) {
+        return false;
+    }
+    addTo(other.sumw_, &sumw_);
+    addTo(other.sumw2_, &sumw2_);
+    entries_ += other.entries_;
+    return true;
+}
+
+double lowerEdgeOf(const Binning &b, std::size_t i) {
+    if (i == 0) { return -std::numeric_limits<double>::infinity(); }
+    return i > b.num_bins() ? b.high() : b.lower_edge(i);
+}
+
+double upperEdgeOf(const Binning &b, std::size_t i) {
+    if (i > b.num_bins()) { return std::numeric_limits<double>::infinity(); }
+    return i == 0 ? b.low() : b.upper_edge(i);
+}
+
+void writeBins(const Histogram1D &h, char sep, std::ostream *os) {
+    const std::streamsize precision =
+        os->precision(std::numeric_limits<double>::max_digits10);
+    for (std::size_t i = 0; i <= h.num_bins() + 1; ++i) {
+        *os << i << sep << lowerEdgeOf(h.binning(), i) << sep
+            << upperEdgeOf(h.binning(), i) << sep << h.content(i) << sep
+            << h.error(i) << '\n';
+    }
+    os->precision(precision);
+}
+
+void writeBins(const Histogram2D &h, char sep, std::ostream *os) {
+    const std::streamsize precision =
+        os->precision(std::numeric_limits<double>::max_digits10);
+    const Binning &xb = h.xbinning(), &yb = h.ybinning();
+    for (std::size_t iy = 0; iy <= yb.num_bins() + 1; ++iy) {
+        for (std::size_t ix = 0; ix <= xb.num_bins() + 1; ++ix) {
+            *os << ix << sep << iy << sep << lowerEdgeOf(xb, ix) << sep
+                << upperEdgeOf(xb, ix) << sep << lowerEdgeOf(yb, iy) << sep
+                << upperEdgeOf(yb, iy) << sep << h.content(ix, iy) << sep
+                << h.error(ix, iy) << '\n';
+        }
+    }
+    os->precision(precision);
+}
+
+void writeCsv(const Histogram1D &h, std::ostream *os) {
+    *os << "bin,low,high,content,error\n";
+    writeBins(h, ',', os);
+}
+
+void writeCsv(const Histogram2D &h, std::ostream *os) {
+    *os << "xbin,ybin,xlow,xhigh,ylow,yhigh,content,error\n";
+    writeBins(h, ',', os);
+}
+
+void writeText(const Histogram1D &h, std::ostream *os) {
+    *os << "# bin low high content error\n";
+    writeBins(h, ' ', os);
+}
+
+void writeText(const Histogram2D &h, std::ostream *os) {
+    *os << "# xbin ybin xlow xhigh ylow yhigh content error\n";
+    writeBins(h, ' ', os);
+}
+}  // namespace lhco
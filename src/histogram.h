@@ -0,0 +1,185 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#ifndef SRC_HISTOGRAM_H_
+#define SRC_HISTOGRAM_H_
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+namespace lhco {
+/*
+ * Bin edges of one axis, either num_bins bins of equal width in [low, high)
+ * or the bins between the given edges. Bin 0 is the underflow and bin
+ * num_bins() + 1 is the overflow, as in ROOT. Invalid arguments (no bins,
+ * low >= high, or edges not increasing) give a binning without bins.
+ */
+class Binning {
+private:
+    std::vector<double> edges_;
+    bool uniform_ = true;
+
+public:
+    Binning() {}
+    Binning(std::size_t num_bins, double low, double high);
+    explicit Binning(const std::vector<double> &edges);
+
+    std::size_t num_bins() const {
+        return edges_.empty() ? 0 : edges_.size() - 1;
+    }
+    bool uniform() const { return uniform_; }
+    double low() const { return edges_.empty() ? 0.0 : edges_.front(); }
+    double high() const { return edges_.empty() ? 0.0 : edges_.back(); }
+    // The edges of bin i in [1, num_bins()].
+    double lower_edge(std::size_t i) const { return edges_[i - 1]; }
+    double upper_edge(std::size_t i) const { return edges_[i]; }
+
+    // The bin containing x. NaN goes to the underflow.
+    std::size_t find(double x) const;
+
+    bool operator==(const Binning &rhs) const {
+        return uniform_ == rhs.uniform_ && edges_ == rhs.edges_;
+    }
+    bool operator!=(const Binning &rhs) const { return !(*this == rhs); }
+};
+
+/*
+ * Weighted one-dimensional histogram. It is not synchronized: to fill from
+ * several threads, give each thread its own shard with HistogramShards.
+ */
+class Histogram1D {
+private:
+    Binning binning_;
+    std::vector<double> sumw_;
+    std::vector<double> sumw2_;
+    std::size_t entries_ = 0;
+
+public:
+    Histogram1D() : Histogram1D(Binning()) {}
+    explicit Histogram1D(const Binning &binning)
+        : binning_(binning),
+          sumw_(binning.num_bins() + 2, 0.0),
+          sumw2_(binning.num_bins() + 2, 0.0) {}
+    Histogram1D(std::size_t num_bins, double low, double high)
+        : Histogram1D(Binning(num_bins, low, high)) {}
+
+    void fill(double x, double w = 1.0) {
+        const std::size_t i = binning_.find(x);
+        sumw_[i] += w;
+        sumw2_[i] += w * w;
+        ++entries_;
+    }
+
+    const Binning &binning() const { return binning_; }
+    std::size_t num_bins() const { return binning_.num_bins(); }
+    std::size_t entries() const { return entries_; }
+    // Sum of weights in bin i, including the underflow and the overflow.
+    double content(std::size_t i) const { return sumw_[i]; }
+    double error(std::size_t i) const;
+    // Sum of weights in the bins, excluding the underflow and the overflow.
+    double integral() const;
+
+    void reset();
+    // Adds the other histogram bin by bin. False if the binnings differ.
+    bool merge(const Histogram1D &other);
+};
+
+// Weighted two-dimensional histogram, not synchronized as Histogram1D.
+class Histogram2D {
+private:
+    Binning xbinning_;
+    Binning ybinning_;
+    std::vector<double> sumw_;
+    std::vector<double> sumw2_;
+    std::size_t entries_ = 0;
+
+    std::size_t index(std::size_t ix, std::size_t iy) const {
+        return iy * (xbinning_.num_bins() + 2) + ix;
+    }
+
+public:
+    Histogram2D() : Histogram2D(Binning(), Binning()) {}
+    Histogram2D(const Binning &xbinning, const Binning &ybinning)
+        : xbinning_(xbinning),
+          ybinning_(ybinning),
+          sumw_((xbinning.num_bins() + 2) * (ybinning.num_bins() + 2), 0.0),
+          sumw2_(sumw_.size(), 0.0) {}
+
+    void fill(double x, double y, double w = 1.0) {
+        const std::size_t i = index(xbinning_.find(x), ybinning_.find(y));
+        sumw_[i] += w;
+        sumw2_[i] += w * w;
+        ++entries_;
+    }
+
+    const Binning &xbinning() const { return xbinning_; }
+    const Binning &ybinning() const { return ybinning_; }
+    std::size_t entries() const { return entries_; }
+    double content(std::size_t ix, std::size_t iy) const {
+        return sumw_[index(ix, iy)];
+    }
+    double error(std::size_t ix, std::size_t iy) const;
+    double integral() const;
+
+    void reset();
+    bool merge(const Histogram2D &other);
+};
+
+/*
+ * One copy of a histogram per thread. Each thread fills only shard(i) of its
+ * own index, so that filling needs no locks, and merged() adds up the shards
+ * in the order of the index. The shards are allocated separately to keep the
+ * threads off each other's cache lines.
+ *
+ * The merged sums are reproducible as long as every event goes to the same
+ * shard from run to run, as forEachEvent in pipeline.h does for a fixed
+ * number of workers.
+ */
+template <typename Histogram>
+class HistogramShards {
+private:
+    std::vector<std::unique_ptr<Histogram>> shards_;
+
+public:
+    HistogramShards(const Histogram &empty, std::size_t num_shards) {
+        if (num_shards == 0) { num_shards = 1; }
+        for (std::size_t i = 0; i < num_shards; ++i) {
+            shards_.emplace_back(new Histogram(empty));
+        }
+    }
+
+    std::size_t num_shards() const { return shards_.size(); }
+    Histogram &shard(std::size_t i) { return *shards_[i]; }
+    const Histogram &shard(std::size_t i) const { return *shards_[i]; }
+
+    Histogram merged() const {
+        Histogram h(*shards_.front());
+        for (std::size_t i = 1; i < shards_.size(); ++i) {
+            h.merge(*shards_[i]);
+        }
+        return h;
+    }
+
+    void reset() {
+        for (auto &s : shards_) { s->reset(); }
+    }
+};
+
+/*
+ * Writes the bins, including the underflow and the overflow, one per line:
+ * "bin,low,high,content,error" for 1D and
+ * "xbin,ybin,xlow,xhigh,ylow,yhigh,content,error" for 2D. The underflow and
+ * the overflow have -inf and inf as their outer edges.
+ */
+void writeCsv(const Histogram1D &h, std::ostream *os);
+
+void writeCsv(const Histogram2D &h, std::ostream *os);
+
+// The same columns separated by spaces, after a '#' header line.
+void writeText(const Histogram1D &h, std::ostream *os);
+
+void writeText(const Histogram2D &h, std::ostream *os);
+}  // namespace lhco
+
+#endif  // SRC_HISTOGRAM_H_
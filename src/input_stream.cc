@@ -0,0 +1,236 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#include "input_stream.h"
+#include <condition_variable>
+#include <cstddef>
+#include <fstream>
+#include <ios>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif  // HAVE_CONFIG_H
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif  // HAVE_ZLIB
+
+namespace lhco {
+bool isGzip(const char *first, const char *last) {
+    return last - first >= 2 && static_cast<unsigned char>(first[0]) == 0x1f &&
+           static_cast<unsigned char>(first[1]) == 0x8b;
+}
+
+#ifdef HAVE_ZLIB
+/*
+ * The decompressing thread fills the buffers of the ring in turn, and the
+ * get area of the stream points into the buffer being read. A buffer is
+ * handed back to the thread when the stream moves on to the next one.
+ */
+class GzipStreamBuf : public std::streambuf {
+private:
+    struct Slot {
+        std::vector<char> data;
+        std::size_t size = 0;
+        bool filled = false;
+        bool last = false;  // no data after this buffer
+    };
+
+    std::ifstream file_;
+    std::vector<Slot> slots_;
+    std::size_t current_ = 0;
+    bool reading_ = false;  // the get area points into slots_[current_]
+    bool stop_ = false;
+    bool error_ = false;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::thread thread_;
+
+    void decompress();
+
+protected:
+    int_type underflow();
+
+public:
+    GzipStreamBuf(const std::string &filename, std::size_t buffer_size,
+                  std::size_t num_buffers)
+        : file_(filename, std::ios::binary),
+          slots_(num_buffers > 1 ? num_buffers : 2) {
+        for (auto &slot : slots_) { slot.data.resize(buffer_size); }
+        thread_ = std::thread(&GzipStreamBuf::decompress, this);
+    }
+    ~GzipStreamBuf() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cond_.notify_all();
+        thread_.join();
+    }
+
+    bool error() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return error_;
+    }
+};
+
+void GzipStreamBuf::decompress() {
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    strm.next_in = Z_NULL;
+    strm.avail_in = 0;
+    // 32 lets zlib detect the gzip (or zlib) header.
+    bool ok = inflateInit2(&strm, 15 + 32) == Z_OK;
+    if (!ok) {
+        // The reader would otherwise wait forever for the first buffer.
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            slots_[0].size = 0;
+            slots_[0].last = true;
+            slots_[0].filled = true;
+            error_ = true;
+        }
+        cond_.notify_all();
+        return;
+    }
+    std::vector<char> input(1 << 20);
+    bool input_done = false, stream_end = false;
+
+    for (std::size_t i = 0; ok; i = (i + 1) % slots_.size()) {
+        Slot &slot = slots_[i];
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cond_.wait(lock, [&]() { return stop_ || !slot.filled; });
+            if (stop_) { break; }
+        }
+
+        strm.next_out = reinterpret_cast<Bytef *>(slot.data.data());
+        strm.avail_out = static_cast<uInt>(slot.data.size());
+        bool last = false;
+        while (strm.avail_out > 0) {
+            if (strm.avail_in == 0 && !input_done) {
+                file_.read(input.data(), input.size());
+                strm.next_in = reinterpret_cast<Bytef *>(input.data());
+                strm.avail_in = static_cast<uInt>(file_.gcount());
+                input_done = strm.avail_in == 0;
+            }
+            if (strm.avail_in == 0 && input_done) {
+                ok = stream_end;
+                last = true;
+                break;
+            }
+            const int ret = inflate(&strm, Z_NO_FLUSH);
+            if (ret == Z_STREAM_END) {
+                // Files may hold several gzip members one after another.
+                stream_end = true;
+                inflateReset(&strm);
+            } else if (ret == Z_OK || ret == Z_BUF_ERROR) {
+                stream_end = false;
+            } else {
+                ok = false;
+                last = true;
+                break;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            slot.size = slot.data.size() - strm.avail_out;
+            slot.last = last;
+            slot.filled = true;
+            if (!ok) { error_ = true; }
+        }
+        cond_.notify_all();
+        if (last) { break; }
+    }
+    inflateEnd(&strm);
+}
+
+GzipStreamBuf::int_type GzipStreamBuf::underflow() {
+    if (gptr() < egptr()) { return traits_type::to_int_type(*gptr()); }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        if (reading_) {
+            Slot &done = slots_[current_];
+            if (done.last) {
+                // The stream catches it and sets badbit.
+                if (error_) { throw std::ios_base::failure("corrupt gzip"); }
+                return traits_type::eof();
+            }
+            done.filled = false;
+            current_ = (current_ + 1) % slots_.size();
+            reading_ = false;
+            cond_.notify_all();
+        }
+        cond_.wait(lock, [&]() { return slots_[current_].filled; });
+        Slot &slot = slots_[current_];
+        reading_ = true;
+        if (slot.size > 0) {
+            char *first = slot.data.data();
+            setg(first, first, first + slot.size);
+            return traits_type::to_int_type(*gptr());
+        }
+    }
+}
+#endif  // HAVE_ZLIB
+
+InputStream::~InputStream() { close(); }
+
+bool InputStream::open(const std::string &filename, std::size_t buffer_size,
+                       std::size_t num_buffers) {
+    close();
+    char magic[2] = {0, 0};
+    {
+        std::ifstream is(filename, std::ios::binary);
+        if (!is) {
+            setstate(std::ios::failbit);
+            return false;
+        }
+        is.read(magic, 2);
+        compressed_ = isGzip(magic, magic + is.gcount());
+    }
+
+    if (compressed_) {
+#ifdef HAVE_ZLIB
+        buf_.reset(new GzipStreamBuf(filename, buffer_size, num_buffers));
+#else
+        static_cast<void>(buffer_size);
+        static_cast<void>(num_buffers);
+#endif
+    } else {
+        std::filebuf *fb = new std::filebuf;
+        buf_.reset(fb);
+        if (!fb->open(filename, std::ios::in | std::ios::binary)) {
+            buf_.reset();
+        }
+    }
+
+    rdbuf(buf_.get());
+    if (buf_ == nullptr) {
+        setstate(std::ios::failbit);
+        return false;
+    }
+    clear();
+    return true;
+}
+
+bool InputStream::error() const {
+    if (bad()) { return true; }
+#ifdef HAVE_ZLIB
+    if (compressed_ && buf_ != nullptr) {
+        return static_cast<GzipStreamBuf *>(buf_.get())->error();
+    }
+#endif  // HAVE_ZLIB
+    return false;
+}
+
+void InputStream::close() {
+    rdbuf(nullptr);
+    buf_.reset();
+    compressed_ = false;
+}
+}  // namespace lhco
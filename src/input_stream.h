@@ -0,0 +1,58 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#ifndef SRC_INPUT_STREAM_H_
+#define SRC_INPUT_STREAM_H_
+
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <streambuf>
+#include <string>
+
+namespace lhco {
+// True if the buffer starts with the magic bytes of gzip.
+bool isGzip(const char *first, const char *last);
+
+/*
+ * Input file stream that can be passed to parseRawEvent and parseEvent.
+ * Files compressed with gzip are detected by their magic bytes and
+ * decompressed on a background thread into a ring of num_buffers buffers of
+ * buffer_size bytes, which the stream reads from without copying. Other
+ * files are read as they are.
+ *
+ * Compressed files cannot be opened if the library was built without zlib.
+ *
+ * A corrupt or truncated compressed file ends the stream as if it were the
+ * end of the file, so callers must check error() after reading to tell the
+ * two apart.
+ */
+class InputStream : public std::istream {
+private:
+    std::unique_ptr<std::streambuf> buf_;
+    bool compressed_ = false;
+
+public:
+    static const std::size_t kDefaultBufferSize = 4 << 20;
+    static const std::size_t kDefaultNumBuffers = 4;
+
+    InputStream() : std::istream(nullptr) {}
+    explicit InputStream(const std::string &filename,
+                         std::size_t buffer_size = kDefaultBufferSize,
+                         std::size_t num_buffers = kDefaultNumBuffers)
+        : std::istream(nullptr) {
+        open(filename, buffer_size, num_buffers);
+    }
+    ~InputStream();
+
+    bool open(const std::string &filename,
+              std::size_t buffer_size = kDefaultBufferSize,
+              std::size_t num_buffers = kDefaultNumBuffers);
+    void close();
+    bool is_open() const { return buf_ != nullptr; }
+    bool compressed() const { return compressed_; }
+    // True if the compressed data was corrupt or truncated, or a read failed.
+    bool error() const;
+};
+}  // namespace lhco
+
+#endif  // SRC_INPUT_STREAM_H_
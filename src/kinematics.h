@@ -78,6 +78,65 @@ struct ThreeMomentum {
         return ptot == 0.0 ? 1.0 : pz.value / ptot;
     }
 };
+
+/*
+ * Difference of two azimuthal angles, in [-pi, pi). It is NaN if either
+ * angle is infinite or NaN.
+ */
+inline double deltaPhi(double phi1, double phi2) {
+    const double pi = 3.14159265358979323846;
+    double dphi = phi1 - phi2;
+    // Far out of range, where the loops below would take too many turns or
+    // never end, as for infinity.
+    if (!(std::abs(dphi) <= 4.0 * pi)) { dphi = std::fmod(dphi, 2.0 * pi); }
+    while (dphi >= pi) { dphi -= 2.0 * pi; }
+    while (dphi < -pi) { dphi += 2.0 * pi; }
+    return dphi;
+}
+
+inline double deltaR(double eta1, double phi1, double eta2, double phi2) {
+    const double deta = eta1 - eta2, dphi = deltaPhi(phi1, phi2);
+    return std::sqrt(deta * deta + dphi * dphi);
+}
+
+/*
+ * Sum of four-momenta that only adds up the components. The mass, pt, eta,
+ * and phi of the sum are derived once when they are asked for.
+ */
+class LorentzSum {
+private:
+    double e_ = 0.0;
+    double px_ = 0.0;
+    double py_ = 0.0;
+    double pz_ = 0.0;
+
+public:
+    LorentzSum() {}
+    LorentzSum(const Energy &e, const Px &px, const Py &py, const Pz &pz)
+        : e_(e.value), px_(px.value), py_(py.value), pz_(pz.value) {}
+
+    // P can be any type with energy(), px(), py(), and pz().
+    template <typename P>
+    LorentzSum &operator+=(const P &p) {
+        e_ += p.energy();
+        px_ += p.px();
+        py_ += p.py();
+        pz_ += p.pz();
+        return *this;
+    }
+
+    double energy() const { return e_; }
+    double px() const { return px_; }
+    double py() const { return py_; }
+    double pz() const { return pz_; }
+
+    double mass() const {
+        return invariantMass(Energy(e_), Px(px_), Py(py_), Pz(pz_));
+    }
+    double pt() const { return std::hypot(px_, py_); }
+    double eta() const { return pseudoRapidity(Px(px_), Py(py_), Pz(pz_)); }
+    double phi() const { return std::atan2(py_, px_); }
+};
 }  // namespace lhco
 
 #endif  // SRC_KINEMATICS_H_
@@ -60,8 +60,6 @@ int numAllJet(const Pt &pt, const Eta &eta, const Event &ev) {
 double missingET(const Event &ev) { return ev.met().pt(); }
 
 double invariantMass(const Visibles &ps) {
-    Visible vis{Energy(0.0), Px(0.0), Py(0.0), Pz(0.0)};
-    for (const auto &p : ps) { vis += p; }
-    return vis.mass();
+    return invariantMass(ps.begin(), ps.end());
 }
 }  // namespace lhco
@@ -3,14 +3,17 @@
 #ifndef SRC_LHCO_H_
 #define SRC_LHCO_H_
 
+#include <cstddef>
 #include <string>
+#include <vector>
 #include "event.h"
+#include "kinematics.h"
 #include "object.h"
 #include "parser.h"
 #include "particle.h"
 
 namespace lhco {
-std::string openingLine() {
+inline std::string openingLine() {
     std::string line = "  #  ";
     line += "typ      eta    phi      pt    jmas  ntrk  btag   had/em";
     line += "  dum1  dum2";
@@ -48,6 +51,23 @@ int numAllJet(const Pt &pt, const Eta &eta, const Event &ev);
 double missingET(const Event &ev);
 
 double invariantMass(const Visibles &ps);
+
+// Invariant mass of the particles in [first, last).
+template <typename Iter>
+double invariantMass(Iter first, Iter last) {
+    LorentzSum sum;
+    for (; first != last; ++first) { sum += *first; }
+    return sum.mass();
+}
+
+// Invariant mass of the particles at the given positions of ps.
+template <typename T>
+double invariantMass(const std::vector<T> &ps,
+                     const std::vector<std::size_t> &indices) {
+    LorentzSum sum;
+    for (const auto &i : indices) { sum += ps[i]; }
+    return sum.mass();
+}
 }  // namespace lhco
 
 #endif  // SRC_LHCO_H_
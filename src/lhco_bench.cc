@@ -0,0 +1,374 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "event.h"
+#include "lhco.h"
+#include "parser.h"
+#include "reader.h"
+#include "synthetic.h"
+#include "writer.h"
+
+/*
+ * relative is the speed against the reference loop of the same run, which
+ * takes out most of the speed of the machine. The baseline is compared on
+ * it.
+ */
+struct BenchResult {
+    std::string name;
+    double events_per_sec;
+    double mb_per_sec;
+    double relative;
+};
+
+template <typename Run>
+double timeOf(Run run) {
+    const auto start = std::chrono::steady_clock::now();
+    run();
+    const std::chrono::duration<double> t =
+        std::chrono::steady_clock::now() - start;
+    return t.count();
+}
+
+// The best of reps runs, in seconds.
+template <typename Run>
+double bestTime(int reps, Run run) {
+    double best = 0.0;
+    for (int i = 0; i < reps; ++i) {
+        const double t = timeOf(run);
+        if (i == 0 || t < best) { best = t; }
+    }
+    return best;
+}
+
+// The sum of the results, so that the compiler cannot drop the work.
+volatile double sink = 0.0;
+
+/*
+ * Reads the numbers of the input digit by digit. Each byte depends on the
+ * previous one as in the parsers, so it cannot be vectorized.
+ */
+double referenceTime(const std::string &text, int reps) {
+    return bestTime(reps, [&]() {
+        std::uint64_t value = 0, sum = 0;
+        for (const char c : text) {
+            if (c >= '0' && c <= '9') {
+                value = value * 10 + static_cast<std::uint64_t>(c - '0');
+            } else {
+                sum += value;
+                value = 0;
+            }
+        }
+        sink = sink + static_cast<double>(sum);
+    });
+}
+
+std::vector<BenchResult> runBenchmarks(const std::string &text, int reps) {
+    std::vector<BenchResult> results;
+    const double reference = referenceTime(text, reps);
+    auto mkResult = [reference](const std::string &name,
+                                std::size_t num_events, std::size_t num_bytes,
+                                double seconds) {
+        return BenchResult{name, num_events / seconds,
+                           num_bytes / seconds / 1.0e+6, reference / seconds};
+    };
+
+    std::vector<lhco::RawEvent> raws;
+    {
+        std::istringstream is(text);
+        for (lhco::RawEvent ev = lhco::parseRawEvent(&is); !ev.empty();
+             ev = lhco::parseRawEvent(&is)) {
+            raws.push_back(ev);
+        }
+    }
+    const std::size_t n = raws.size(), size = text.size();
+    results.push_back(mkResult("reference", n, size, reference));
+
+    double t = bestTime(reps, [&]() {
+        std::istringstream is(text);
+        std::size_t count = 0;
+        while (!lhco::parseRawEvent(&is).empty()) { ++count; }
+        sink = sink + count;
+    });
+    results.push_back(mkResult("parseRawEvent/istream", n, size, t));
+
+    t = bestTime(reps, [&]() {
+        const char *pos = text.data(), *last = pos + text.size();
+        lhco::RawEvent ev;
+        std::size_t count = 0;
+        while (lhco::parseRawEvent(&pos, last, &ev) ==
+               lhco::ParseStatus::Complete) {
+            ++count;
+        }
+        sink = sink + count;
+    });
+    results.push_back(mkResult("parseRawEvent/buffer", n, size, t));
+
+    t = bestTime(reps, [&]() {
+        std::istringstream is(text);
+        std::size_t count = 0;
+        while (!lhco::parseEvent(&is).empty()) { ++count; }
+        sink = sink + count;
+    });
+    results.push_back(mkResult("parseEvent", n, size, t));
+
+    std::size_t out_size = 0;
+    t = bestTime(reps, [&]() {
+        std::ostringstream os;
+        for (const auto &ev : raws) { os << ev << '\n'; }
+        out_size = os.str().size();
+    });
+    results.push_back(mkResult("render/operator<<", n, out_size, t));
+
+    t = bestTime(reps, [&]() {
+        std::ostringstream os;
+        {
+            lhco::LhcoWriter writer(&os);
+            for (const auto &ev : raws) { writer.write(ev); }
+        }
+        out_size = os.str().size();
+    });
+    results.push_back(mkResult("render/LhcoWriter", n, out_size, t));
+
+    std::vector<lhco::Event> events;
+    for (const auto &raw : raws) { events.push_back(lhco::mkEvent(raw)); }
+
+    // mkEvent has sorted the particles already, so sort a copy of the
+    // unsorted events built by add_*.
+    std::vector<lhco::Event> unsorted;
+    for (const auto &raw : raws) {
+        lhco::Event ev;
+        for (const auto &obj : raw.objects()) {
+            switch (obj.typ) {
+            case 0:
+                ev.add_photon(obj);
+                break;
+            case 1:
+                ev.add_electron(obj);
+                break;
+            case 2:
+                ev.add_muon(obj);
+                break;
+            case 3:
+                ev.add_tau(obj);
+                break;
+            case 4:
+                if (obj.btag > 0.5) {
+                    ev.add_bjet(obj);
+                } else {
+                    ev.add_jet(obj);
+                }
+                break;
+            default:
+                ev.set_met(obj);
+            }
+        }
+        unsorted.push_back(ev);
+    }
+    auto sortTime = [&](const std::vector<lhco::Event> &input,
+                        lhco::SortMode mode) {
+        double best = 0.0;
+        for (int i = 0; i < reps; ++i) {
+            std::vector<lhco::Event> work(input);
+            for (auto &ev : work) { ev.set_sort_mode(mode, 2); }
+            const double s = timeOf([&]() {
+                for (auto &ev : work) { ev.sort_particles(); }
+            });
+            if (i == 0 || s < best) { best = s; }
+        }
+        return best;
+    };
+    t = sortTime(unsorted, lhco::SortMode::All);
+    results.push_back(mkResult("sort_particles", n, size, t));
+    t = sortTime(unsorted, lhco::SortMode::Leading);
+    results.push_back(mkResult("sort_particles/leading", n, size, t));
+    t = sortTime(events, lhco::SortMode::All);
+    results.push_back(mkResult("sort_particles/presorted", n, size, t));
+
+    t = bestTime(reps, [&]() {
+        const lhco::Pt pt(20.0);
+        const lhco::Eta eta(2.5);
+        int count = 0;
+        for (const auto &ev : events) {
+            count += lhco::numPhoton(pt, eta, ev) +
+                     lhco::numElectron(pt, eta, ev) +
+                     lhco::numMuon(pt, eta, ev) + lhco::numTau(pt, eta, ev) +
+                     lhco::numNormalJet(pt, eta, ev) +
+                     lhco::numBjet(pt, eta, ev) +
+                     (lhco::missingET(ev) > 50.0);
+        }
+        sink = sink + count;
+    });
+    results.push_back(mkResult("num*", n, size, t));
+
+    std::vector<lhco::Visibles> visibles(events.size());
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        const lhco::Event &ev = events[i];
+        lhco::Visibles &vs = visibles[i];
+        vs.insert(vs.end(), ev.photon().begin(), ev.photon().end());
+        vs.insert(vs.end(), ev.electron().begin(), ev.electron().end());
+        vs.insert(vs.end(), ev.muon().begin(), ev.muon().end());
+        vs.insert(vs.end(), ev.jet().begin(), ev.jet().end());
+        vs.insert(vs.end(), ev.bjet().begin(), ev.bjet().end());
+    }
+    t = bestTime(reps, [&]() {
+        double sum = 0.0;
+        for (const auto &vs : visibles) { sum += lhco::invariantMass(vs); }
+        sink = sink + sum;
+    });
+    results.push_back(mkResult("invariantMass", n, size, t));
+
+    return results;
+}
+
+void writeResults(const std::vector<BenchResult> &results, std::ostream *os) {
+    *os << "# benchmark\tevents/s\tMB/s\trelative\n";
+    for (const auto &r : results) {
+        *os << r.name << '\t' << r.events_per_sec << '\t' << r.mb_per_sec
+            << '\t' << r.relative << '\n';
+    }
+}
+
+// Reads the relative speed of each benchmark written by writeResults.
+std::map<std::string, double> readBaseline(std::istream *is) {
+    std::map<std::string, double> baseline;
+    std::string line;
+    while (std::getline(*is, line)) {
+        if (line.empty() || line[0] == '#') { continue; }
+        std::istringstream iss(line);
+        std::string name;
+        double events_per_sec = 0.0, mb_per_sec = 0.0, relative = 0.0;
+        if (std::getline(iss, name, '\t') &&
+            iss >> events_per_sec >> mb_per_sec >> relative) {
+            baseline[name] = relative;
+        }
+    }
+    return baseline;
+}
+
+int usage() {
+    std::cout
+        << "Usage: lhco_bench [options]\n"
+        << "  --events N          number of synthetic events (100000)\n"
+        << "  --size MB           size of the synthetic input, instead of\n"
+        << "                      the number of events\n"
+        << "  --seed N            seed of the generator (1)\n"
+        << "  Mean numbers of objects per event:\n"
+        << "  --photons X (0.5), --electrons X (0.5), --muons X (0.5),\n"
+        << "  --taus X (0.25), --jets X (4) including the b-jets\n"
+        << "  --leptons X         the same as --electrons X --muons X\n"
+        << "  --bjet-fraction X   fraction of the jets that are b-jets (0.2)\n"
+        << "  --comment-every N   comment line every N events (20)\n"
+        << "  --reps N            runs of each benchmark, best taken (5)\n"
+        << "  --baseline FILE     fail if slower than FILE by the tolerance\n"
+        << "  --tolerance X       allowed slowdown (0.25 = 25%)\n"
+        << "  --write-baseline FILE  save the results to FILE\n"
+        << "  --generate          write the synthetic events to stdout\n"
+        << "The results are written to stdout as tab-separated values. The\n"
+        << "speeds relative to a reference loop over the input are compared\n"
+        << "with the baseline, which should come from the same machine.\n";
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    lhco::SyntheticConfig config;
+    int reps = 5;
+    double tolerance = 0.25;
+    std::string baseline_file, output_file;
+    bool generate = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string opt = argv[i];
+        if (opt == "--generate") {
+            generate = true;
+            continue;
+        }
+        if (i + 1 >= argc) { return usage(); }
+        const char *val = argv[++i];
+        if (opt == "--events") {
+            config.num_events = std::strtoul(val, nullptr, 10);
+        } else if (opt == "--size") {
+            config.num_bytes =
+                static_cast<std::size_t>(std::atof(val) * 1.0e+6);
+        } else if (opt == "--seed") {
+            config.seed = std::strtoull(val, nullptr, 10);
+        } else if (opt == "--jets") {
+            config.mean_jets = std::atof(val);
+        } else if (opt == "--photons") {
+            config.mean_photons = std::atof(val);
+        } else if (opt == "--electrons") {
+            config.mean_electrons = std::atof(val);
+        } else if (opt == "--muons") {
+            config.mean_muons = std::atof(val);
+        } else if (opt == "--taus") {
+            config.mean_taus = std::atof(val);
+        } else if (opt == "--bjet-fraction") {
+            config.bjet_fraction = std::atof(val);
+        } else if (opt == "--leptons") {
+            config.mean_electrons = config.mean_muons = std::atof(val);
+        } else if (opt == "--comment-every") {
+            config.comment_every = std::strtoul(val, nullptr, 10);
+        } else if (opt == "--reps") {
+            reps = std::atoi(val) > 0 ? std::atoi(val) : 1;
+        } else if (opt == "--baseline") {
+            baseline_file = val;
+        } else if (opt == "--tolerance") {
+            tolerance = std::atof(val);
+        } else if (opt == "--write-baseline") {
+            output_file = val;
+        } else {
+            return usage();
+        }
+    }
+
+    if (generate) {
+        lhco::writeSynthetic(config, &std::cout);
+        return 0;
+    }
+
+    std::ostringstream os;
+    lhco::writeSynthetic(config, &os);
+    const std::vector<BenchResult> results = runBenchmarks(os.str(), reps);
+    writeResults(results, &std::cout);
+
+    if (!output_file.empty()) {
+        std::ofstream out(output_file);
+        writeResults(results, &out);
+        if (!out) {
+            std::cerr << "-- Cannot write \"" << output_file << "\".\n";
+            return 1;
+        }
+    }
+
+    if (baseline_file.empty()) { return 0; }
+    std::ifstream in(baseline_file);
+    if (!in) {
+        std::cerr << "-- Cannot open baseline \"" << baseline_file << "\".\n";
+        return 1;
+    }
+    const std::map<std::string, double> baseline = readBaseline(&in);
+    int num_regressions = 0;
+    for (const auto &r : results) {
+        const auto it = baseline.find(r.name);
+        if (it == baseline.end()) { continue; }
+        if (r.relative < it->second * (1.0 - tolerance)) {
+            std::cerr << "-- " << r.name << ": " << r.relative
+                      << " times the reference, baseline " << it->second
+                      << '\n';
+            ++num_regressions;
+        }
+    }
+    if (num_regressions > 0) {
+        std::cerr << "-- " << num_regressions << " benchmark(s) regressed by "
+                  << "more than " << tolerance * 100.0 << "%.\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,65 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#include <fstream>
+#include <iostream>
+#include "binary_format.h"
+#include "input_stream.h"
+#include "mapped_file.h"
+#include "reader.h"
+
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        std::cout << "Usage: lhco_convert input output\n"
+                  << "    - input: Input file in LHC Olympics format "
+                  << "(text or binary)\n"
+                  << "    - output: Output file in the other format\n";
+        return 1;
+    }
+
+    bool to_text = false, compressed = false;
+    {
+        lhco::MappedFile input(argv[1]);
+        if (!input.is_open()) {
+            std::cerr << "-- Cannot open input file \"" << argv[1] << "\".\n";
+            return 1;
+        }
+        to_text = lhco::isBinaryLHCO(input.begin(), input.end());
+        compressed = lhco::isGzip(input.begin(), input.end());
+    }
+
+    std::ofstream output(argv[2], std::ios::binary);
+    if (!output) {
+        std::cerr << "-- Cannot open output file \"" << argv[2] << "\".\n";
+        return 1;
+    }
+
+    std::size_t num_eve = 0;
+    if (to_text) {
+        std::cout << "-- Converting \"" << argv[1] << "\" to text ...\n";
+        lhco::BinaryReader reader(argv[1]);
+        if (!reader.is_open()) {
+            std::cerr << "-- Invalid binary file \"" << argv[1] << "\".\n";
+            return 1;
+        }
+        num_eve = lhco::convertToText(reader, &output);
+    } else {
+        std::cout << "-- Converting \"" << argv[1] << "\" to binary ...\n";
+        if (compressed) {
+            lhco::InputStream input(argv[1]);
+            num_eve = lhco::convertToBinary(&input, &output);
+            if (input.error()) {
+                std::cerr << "-- Corrupt or truncated input file \""
+                          << argv[1] << "\" after " << num_eve
+                          << " events.\n";
+                return 1;
+            }
+        } else {
+            lhco::Reader reader(argv[1]);
+            num_eve = lhco::convertToBinary(&reader, &output);
+        }
+    }
+
+    std::cout << "-- " << num_eve << " events written to \"" << argv[2]
+              << "\".\n";
+    output.close();
+}
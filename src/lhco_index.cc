@@ -0,0 +1,36 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#include <cstdlib>
+#include <iostream>
+#include "event_index.h"
+#include "reader.h"
+
+int main(int argc, char *argv[]) {
+    if (argc != 2 && argc != 3) {
+        std::cout << "Usage: lhco_index input [event_number]\n"
+                  << "    - input: Input file in LHC Olympics format\n"
+                  << "    - event_number: Print the event with this number\n"
+                  << "  The index is saved as \"input.idx\".\n";
+        return 1;
+    }
+
+    lhco::Reader reader(argv[1]);
+    if (!reader.is_open()) {
+        std::cerr << "-- Cannot open input file \"" << argv[1] << "\".\n";
+        return 1;
+    }
+
+    const lhco::EventIndex index = lhco::loadOrBuildIndex(argv[1], reader);
+    if (argc == 2) {
+        std::cout << "-- " << index.size() << " events indexed in \""
+                  << lhco::indexFilename(argv[1]) << "\".\n";
+        return 0;
+    }
+
+    const int event_number = std::atoi(argv[2]);
+    if (!lhco::seekEventNumber(index, event_number, &reader)) {
+        std::cerr << "-- No event number " << event_number << ".\n";
+        return 1;
+    }
+    std::cout << reader.next_raw_event() << '\n';
+}
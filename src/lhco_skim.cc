@@ -0,0 +1,111 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "cut_flow.h"
+#include "input_stream.h"
+#include "mapped_file.h"
+#include "skim.h"
+
+int usage() {
+    std::cout
+        << "Usage: lhco_skim [options] input output\n"
+        << "    - input: Input file in LHC Olympics format\n"
+        << "    - output: Output file with the events passing the cuts\n"
+        << "  Options (the numbers are the minimum numbers of objects):\n"
+        << "    --pt X           count only the objects with pt > X (0)\n"
+        << "    --eta X          count only the objects with |eta| < X (10)\n"
+        << "    --photons N, --electrons N, --muons N, --taus N,\n"
+        << "    --jets N         all the jets including the b-jets\n"
+        << "    --bjets N\n"
+        << "    --met X          missing ET > X\n"
+        << "  The events are copied byte for byte from the input.\n";
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    double pt = 0.0, eta = 10.0;
+    struct Count {
+        const char *option;
+        lhco::ObjectKind kind;
+        int n;
+    } counts[] = {{"--photons", lhco::ObjectKind::Photon, 0},
+                  {"--electrons", lhco::ObjectKind::Electron, 0},
+                  {"--muons", lhco::ObjectKind::Muon, 0},
+                  {"--taus", lhco::ObjectKind::Tau, 0},
+                  {"--jets", lhco::ObjectKind::AllJet, 0},
+                  {"--bjets", lhco::ObjectKind::Bjet, 0}};
+    double met = -1.0;
+    std::string files[2];
+    int num_files = 0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string opt = argv[i];
+        if (opt.compare(0, 2, "--") != 0) {
+            if (num_files == 2) { return usage(); }
+            files[num_files++] = opt;
+            continue;
+        }
+        if (i + 1 >= argc) { return usage(); }
+        const char *val = argv[++i];
+        bool known = true;
+        if (opt == "--pt") {
+            pt = std::atof(val);
+        } else if (opt == "--eta") {
+            eta = std::atof(val);
+        } else if (opt == "--met") {
+            met = std::atof(val);
+        } else {
+            known = false;
+            for (auto &c : counts) {
+                if (opt == c.option) {
+                    c.n = std::atoi(val);
+                    known = true;
+                }
+            }
+        }
+        if (!known) { return usage(); }
+    }
+    if (num_files != 2) { return usage(); }
+
+    lhco::CutFlow cut_flow;
+    for (const auto &c : counts) {
+        if (c.n > 0) {
+            cut_flow.add(c.option + 2, c.kind, lhco::Pt(pt), lhco::Eta(eta),
+                         lhco::Comparison::GreaterEqual, c.n);
+        }
+    }
+    if (met >= 0.0) {
+        cut_flow.add_missing_et("met", lhco::Comparison::Greater, met);
+    }
+
+    lhco::MappedFile input(files[0]);
+    if (!input.is_open()) {
+        std::cerr << "-- Cannot open input file \"" << files[0] << "\".\n";
+        return 1;
+    }
+    if (lhco::isGzip(input.begin(), input.end())) {
+        std::cerr << "-- \"" << files[0] << "\" is compressed with gzip, "
+                  << "and the events can only be copied from plain text.\n";
+        return 1;
+    }
+    std::ofstream output(files[1], std::ios::binary);
+    if (!output) {
+        std::cerr << "-- Cannot open output file \"" << files[1] << "\".\n";
+        return 1;
+    }
+
+    const lhco::SkimResult result = lhco::skimEvents(
+        input.begin(), input.end(),
+        [&](const lhco::Event &ev) { return cut_flow.pass(ev); }, &output);
+    output.close();
+    if (!output) {
+        std::cerr << "-- Cannot write output file \"" << files[1] << "\".\n";
+        return 1;
+    }
+
+    if (cut_flow.num_cuts() > 0) { lhco::writeCutFlow(cut_flow, &std::cout); }
+    std::cout << "-- " << result.num_kept << " of " << result.num_events
+              << " events written to \"" << files[1] << "\".\n";
+}
@@ -0,0 +1,94 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#include "mapped_file.h"
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif  // HAVE_CONFIG_H
+#if defined(HAVE_MMAP) && defined(HAVE_SYS_MMAN_H)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define LHCO_USE_MMAP 1
+#endif
+
+namespace lhco {
+MappedFile::MappedFile(MappedFile &&other)
+    : data_(other.data_),
+      size_(other.size_),
+      open_(other.open_),
+      mapped_(other.mapped_),
+      buffer_(std::move(other.buffer_)) {
+    if (!mapped_) { data_ = buffer_.data(); }
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.open_ = other.mapped_ = false;
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) {
+    if (this != &other) {
+        release();
+        data_ = other.data_;
+        size_ = other.size_;
+        open_ = other.open_;
+        mapped_ = other.mapped_;
+        buffer_ = std::move(other.buffer_);
+        if (!mapped_) { data_ = buffer_.data(); }
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.open_ = other.mapped_ = false;
+    }
+    return *this;
+}
+
+void MappedFile::release() {
+#ifdef LHCO_USE_MMAP
+    if (mapped_) { munmap(const_cast<char *>(data_), size_); }
+#endif
+    buffer_.clear();
+    buffer_.shrink_to_fit();
+    data_ = nullptr;
+    size_ = 0;
+    open_ = mapped_ = false;
+}
+
+bool MappedFile::open(const std::string &filename) {
+    release();
+#ifdef LHCO_USE_MMAP
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) { return false; }
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_ == 0) {
+            ::close(fd);
+            return open_ = true;
+        }
+        void *addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+            ::close(fd);
+#ifdef MADV_SEQUENTIAL
+            madvise(addr, size_, MADV_SEQUENTIAL);
+#endif
+            data_ = static_cast<const char *>(addr);
+            return open_ = mapped_ = true;
+        }
+        size_ = 0;
+    }
+    ::close(fd);
+#endif  // LHCO_USE_MMAP
+
+    // Pipes, special files, or no mmap: read everything into memory.
+    std::ifstream is(filename, std::ios::binary);
+    if (!is) { return false; }
+    buffer_.assign(std::istreambuf_iterator<char>(is),
+                   std::istreambuf_iterator<char>());
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+    return open_ = true;
+}
+}  // namespace lhco
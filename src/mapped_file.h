@@ -0,0 +1,44 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#ifndef SRC_MAPPED_FILE_H_
+#define SRC_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace lhco {
+/*
+ * Read-only view of a whole file. The file is memory-mapped where mmap(2) is
+ * available and read into memory otherwise.
+ */
+class MappedFile {
+private:
+    const char *data_ = nullptr;
+    std::size_t size_ = 0;
+    bool open_ = false;
+    bool mapped_ = false;
+    std::vector<char> buffer_;
+
+    void release();
+
+public:
+    MappedFile() {}
+    explicit MappedFile(const std::string &filename) { open(filename); }
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other);
+    MappedFile &operator=(MappedFile &&other);
+    ~MappedFile() { release(); }
+
+    bool open(const std::string &filename);
+    void close() { release(); }
+    bool is_open() const { return open_; }
+
+    const char *begin() const { return data_; }
+    const char *end() const { return data_ + size_; }
+    std::size_t size() const { return size_; }
+};
+}  // namespace lhco
+
+#endif  // SRC_MAPPED_FILE_H_
@@ -47,6 +47,29 @@ struct Object {
 };
 
 using Objects = std::vector<Object>;
+
+// The collections of Event that an object may belong to.
+enum class ObjectKind { Photon, Electron, Muon, Tau, NormalJet, Bjet, AllJet };
+
+// True if an object with the given typ and btag belongs to the collection.
+inline bool isKind(ObjectKind kind, int typ, int btag) {
+    switch (kind) {
+    case ObjectKind::Photon:
+        return typ == 0;
+    case ObjectKind::Electron:
+        return typ == 1;
+    case ObjectKind::Muon:
+        return typ == 2;
+    case ObjectKind::Tau:
+        return typ == 3;
+    case ObjectKind::NormalJet:
+        return typ == 4 && !(btag > 0.5);
+    case ObjectKind::Bjet:
+        return typ == 4 && btag > 0.5;
+    default:
+        return typ == 4;
+    }
+}
 }  // namespace lhco
 
 #endif  // SRC_OBJECT_H_
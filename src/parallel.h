@@ -0,0 +1,83 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#ifndef SRC_PARALLEL_H_
+#define SRC_PARALLEL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace lhco {
+inline unsigned defaultNumThreads() {
+    const unsigned n = std::thread::hardware_concurrency();
+    return n > 0 ? n : 1;
+}
+
+/*
+ * The first exception caught by any of the threads of a parallel loop.
+ * capture() is called from a catch block, and the other threads poll
+ * stopped() to give up early.
+ */
+class FirstError {
+private:
+    std::atomic<bool> stopped_;
+    std::mutex mutex_;
+    std::exception_ptr error_;
+
+public:
+    FirstError() : stopped_(false) {}
+
+    void capture() {
+        stopped_ = true;
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!error_) { error_ = std::current_exception(); }
+    }
+    bool stopped() const { return stopped_; }
+    // Called once all the threads have been joined.
+    void rethrow() {
+        if (error_) { std::rethrow_exception(error_); }
+    }
+};
+
+/*
+ * Calls task(i) for every i in [0, num_tasks) using up to num_threads
+ * threads (all hardware threads if zero). The tasks are handed out in order
+ * from a shared counter, so the threads stay busy until the last task.
+ * If a task throws, no more tasks are started and the first exception is
+ * rethrown once all the threads have finished.
+ */
+template <typename Task>
+void parallelFor(std::size_t num_tasks, unsigned num_threads, Task task) {
+    if (num_threads == 0) { num_threads = defaultNumThreads(); }
+    num_threads =
+        static_cast<unsigned>(std::min<std::size_t>(num_threads, num_tasks));
+    if (num_threads <= 1) {
+        for (std::size_t i = 0; i < num_tasks; ++i) { task(i); }
+        return;
+    }
+
+    std::atomic<std::size_t> next(0);
+    FirstError error;
+    auto work = [&]() {
+        try {
+            for (std::size_t i = next++; i < num_tasks && !error.stopped();
+                 i = next++) {
+                task(i);
+            }
+        } catch (...) {
+            error.capture();
+        }
+    };
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < num_threads; ++i) { threads.emplace_back(work); }
+    work();
+    for (auto &t : threads) { t.join(); }
+    error.rethrow();
+}
+}  // namespace lhco
+
+#endif  // SRC_PARALLEL_H_
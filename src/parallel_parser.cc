@@ -0,0 +1,206 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#include "parallel_parser.h"
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <vector>
+#include "input_stream.h"
+#include "mapped_file.h"
+#include "parallel.h"
+#include "parser.h"
+#include "reader.h"
+#include "scanner.h"
+
+namespace lhco {
+const char *nextHeaderLine(const char *first, const char *pos,
+                           const char *last) {
+    if (pos > first && pos[-1] != '\n') {
+        pos = endOfLine(pos, last);
+        if (pos < last) { ++pos; }
+    }
+    while (pos < last) {
+        const char *eol = endOfLine(pos, last);
+        if (!isCommentLine(pos, eol)) {
+            Scanner in(pos, eol);
+            int first_digit = -1, second_digit = 0;
+            in >> first_digit >> second_digit;
+            if (!in.fail() && first_digit == 0) { return pos; }
+        }
+        pos = eol == last ? last : eol + 1;
+    }
+    return last;
+}
+
+/*
+ * True if the lines in [pos, last) left after the last complete event of a
+ * chunk cannot change the event that the next chunk begins with, i.e., they
+ * are only comments or blank lines.
+ */
+bool isCleanTail(const char *pos, const char *last) {
+    while (pos < last) {
+        const char *eol = endOfLine(pos, last);
+        if (!isCommentLine(pos, eol)) {
+            for (const char *p = pos; p < eol; ++p) {
+                if (!isSpace(*p)) { return false; }
+            }
+        }
+        pos = eol == last ? last : eol + 1;
+    }
+    return true;
+}
+
+struct Chunk {
+    const char *first;
+    const char *last;
+    bool undefined = false;  // stopped at an undefined line
+    bool clean = true;       // no partial event left at the end
+};
+
+template <typename T, typename Convert>
+void parseChunk(Chunk *chunk, Convert convert, std::vector<T> *events) {
+    const char *pos = chunk->first;
+    RawEvent lhco;
+    while (pos < chunk->last) {
+        const char *event_begin = pos;
+        ParseStatus status = parseRawEvent(&pos, chunk->last, &lhco);
+        if (status == ParseStatus::Complete) {
+            events->push_back(convert(lhco));
+        } else if (status == ParseStatus::Undefined) {
+            chunk->undefined = true;
+            break;
+        } else {
+            chunk->clean = isCleanTail(event_begin, chunk->last);
+            break;
+        }
+    }
+}
+
+template <typename T, typename Convert>
+std::vector<T> parseParallel(const char *first, const char *last,
+                             unsigned num_threads, Convert convert) {
+    if (num_threads == 0) { num_threads = defaultNumThreads(); }
+    const std::size_t min_chunk_size = 1 << 20;
+    std::size_t num_chunks = static_cast<std::size_t>(last - first) /
+                             min_chunk_size;
+    if (num_chunks > 8 * num_threads) { num_chunks = 8 * num_threads; }
+    if (num_chunks == 0) { num_chunks = 1; }
+
+    std::vector<Chunk> chunks;
+    const std::size_t chunk_size = (last - first) / num_chunks;
+    const char *begin = first;
+    for (std::size_t i = 1; i <= num_chunks && begin < last; ++i) {
+        const char *end =
+            i == num_chunks ? last
+                            : nextHeaderLine(first, first + i * chunk_size,
+                                             last);
+        if (end <= begin) { continue; }
+        Chunk chunk;
+        chunk.first = begin;
+        chunk.last = end;
+        chunks.push_back(chunk);
+        begin = end;
+    }
+
+    std::vector<std::vector<T>> results(chunks.size());
+    parallelFor(chunks.size(), num_threads, [&](std::size_t i) {
+        parseChunk(&chunks[i], convert, &results[i]);
+    });
+
+    std::vector<T> events;
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+        if (!chunks[i].clean && i + 1 < chunks.size()) {
+            // A partial event runs into the next chunk: fall back to the
+            // sequential parser from here on.
+            Chunk rest;
+            rest.first = chunks[i].first;
+            rest.last = last;
+            parseChunk(&rest, convert, &events);
+            break;
+        }
+        events.insert(events.end(),
+                      std::make_move_iterator(results[i].begin()),
+                      std::make_move_iterator(results[i].end()));
+        if (chunks[i].undefined) { break; }
+    }
+    return events;
+}
+
+RawEvent identity(const RawEvent &lhco) { return lhco; }
+
+std::vector<RawEvent> parseRawEventsParallel(const char *first,
+                                             const char *last,
+                                             unsigned num_threads) {
+    return parseParallel<RawEvent>(first, last, num_threads, identity);
+}
+
+std::vector<RawEvent> parseRawEventsParallel(const std::string &filename,
+                                             unsigned num_threads) {
+    MappedFile file(filename);
+    if (isGzip(file.begin(), file.end())) { return {}; }
+    return parseRawEventsParallel(file.begin(), file.end(), num_threads);
+}
+
+std::vector<Event> parseEventsParallel(const char *first, const char *last,
+                                       unsigned num_threads) {
+    return parseParallel<Event>(
+        first, last, num_threads,
+        static_cast<Event (*)(const RawEvent &)>(mkEvent));
+}
+
+std::vector<Event> parseEventsParallel(const std::string &filename,
+                                       unsigned num_threads) {
+    MappedFile file(filename);
+    if (isGzip(file.begin(), file.end())) { return {}; }
+    return parseEventsParallel(file.begin(), file.end(), num_threads);
+}
+
+std::size_t countEventsParallel(const char *first, const char *last,
+                                unsigned num_threads) {
+    if (num_threads == 0) { num_threads = defaultNumThreads(); }
+    const std::size_t min_chunk_size = 1 << 20;
+    std::size_t num_chunks = static_cast<std::size_t>(last - first) /
+                             min_chunk_size;
+    if (num_chunks > 8 * num_threads) { num_chunks = 8 * num_threads; }
+    if (num_chunks <= 1) { return countEvents(first, last); }
+
+    // Every event ends at a line for missing energy, so the chunks may
+    // start at any line: the count is the number of such lines before the
+    // first undefined record.
+    std::vector<const char *> bounds(1, first);
+    const std::size_t chunk_size = (last - first) / num_chunks;
+    for (std::size_t i = 1; i < num_chunks; ++i) {
+        const char *pos = endOfLine(first + i * chunk_size - 1, last);
+        if (pos < last) { ++pos; }
+        if (pos > bounds.back()) { bounds.push_back(pos); }
+    }
+    bounds.push_back(last);
+
+    const std::size_t num_bounds = bounds.size() - 1;
+    std::vector<std::size_t> counts(num_bounds, 0);
+    std::vector<char> undefined(num_bounds, 0);
+    parallelFor(num_bounds, num_threads, [&](std::size_t i) {
+        const char *pos = bounds[i];
+        ParseStatus status = ParseStatus::Complete;
+        counts[i] = skipEvents(&pos, bounds[i + 1],
+                               std::numeric_limits<std::size_t>::max(),
+                               &status);
+        undefined[i] = status == ParseStatus::Undefined;
+    });
+
+    std::size_t num_events = 0;
+    for (std::size_t i = 0; i < num_bounds; ++i) {
+        num_events += counts[i];
+        if (undefined[i]) { break; }
+    }
+    return num_events;
+}
+
+std::size_t countEventsParallel(const std::string &filename,
+                                unsigned num_threads) {
+    MappedFile file(filename);
+    if (isGzip(file.begin(), file.end())) { return 0; }
+    return countEventsParallel(file.begin(), file.end(), num_threads);
+}
+}  // namespace lhco
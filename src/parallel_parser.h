@@ -0,0 +1,51 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#ifndef SRC_PARALLEL_PARSER_H_
+#define SRC_PARALLEL_PARSER_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "event.h"
+
+namespace lhco {
+/*
+ * Parses all the events in [first, last) on num_threads threads (all
+ * hardware threads if zero). The buffer is split into chunks beginning at
+ * event header lines, and the results are returned in the original order.
+ * As in the loop over parseRawEvent, parsing stops at the first event that
+ * cannot be read. The overloads taking a file name return nothing for
+ * gzip-compressed files, which cannot be split in place.
+ */
+std::vector<RawEvent> parseRawEventsParallel(const char *first,
+                                             const char *last,
+                                             unsigned num_threads = 0);
+
+std::vector<RawEvent> parseRawEventsParallel(const std::string &filename,
+                                             unsigned num_threads = 0);
+
+std::vector<Event> parseEventsParallel(const char *first, const char *last,
+                                       unsigned num_threads = 0);
+
+std::vector<Event> parseEventsParallel(const std::string &filename,
+                                       unsigned num_threads = 0);
+
+/*
+ * Counts the events in [first, last) as countEvents does, scanning chunks of
+ * the buffer on num_threads threads (all hardware threads if zero).
+ */
+std::size_t countEventsParallel(const char *first, const char *last,
+                                unsigned num_threads = 0);
+
+std::size_t countEventsParallel(const std::string &filename,
+                                unsigned num_threads = 0);
+
+/*
+ * Returns the start of the first event header line at or after pos. If pos
+ * is in the middle of a line, the search begins on the next line.
+ */
+const char *nextHeaderLine(const char *first, const char *pos,
+                           const char *last);
+}  // namespace lhco
+
+#endif  // SRC_PARALLEL_PARSER_H_
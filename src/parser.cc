@@ -1,11 +1,16 @@
 /* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
 
 #include "parser.h"
+#include <cstdint>
 #include <memory>
 #include <sstream>
 #include <string>
 #include <utility>
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif  // HAVE_CONFIG_H
 #include "object.h"
+#include "stats.h"
 
 using std::istringstream;
 
@@ -18,12 +23,16 @@ Object getObj(std::unique_ptr<istringstream> iss, const int &typ) {
 }
 
 RawEvent parseRawEvent(std::istream *is) {
+    LHCO_STAT_TIMER(Parse);
     std::string line;
     Header header;
     Objects objs;
     RawEvent lhco;
+    std::uint64_t num_bytes = 0, num_lines = 0, num_comments = 0;
 
     while (std::getline(*is, line)) {
+        num_bytes += line.size() + (is->eof() ? 0 : 1);
+        ++num_lines;
         if (line.find("#") == std::string::npos) {
             std::unique_ptr<istringstream> iss(new istringstream(line));
             int first_digit = 0, second_digit = 0;
@@ -37,54 +46,85 @@ RawEvent parseRawEvent(std::istream *is) {
             } else if (second_digit == 6) {  // line for missing energy
                 Object obj = getObj(std::move(iss), second_digit);
                 objs.push_back(obj);
-                lhco.set_event(header, objs);
+                lhco.set_event(header, std::move(objs));
+                LHCO_STAT_ADD(Events, 1);
                 break;
             } else {  // undefined line
                 lhco(EventStatus::Empty);
+                LHCO_STAT_ADD(UndefinedLines, 1);
                 break;
             }
         } else {  // comment line
+            ++num_comments;
             continue;
         }
     }
 
+    LHCO_STAT_ADD(BytesRead, num_bytes);
+    LHCO_STAT_ADD(Lines, num_lines);
+    LHCO_STAT_ADD(CommentLines, num_comments);
     return lhco;
 }
 
-Event parseEvent(std::istream *is) {
-    RawEvent raw_ev = parseRawEvent(is);
-    Event ev;
-    if (raw_ev.empty()) {
-        ev(EventStatus::Empty);
-    } else {
-        for (const auto &obj : raw_ev.objects()) {
-            switch (obj.typ) {
-            case 0:  // photon
-                ev.add_photon(obj);
-                break;
-            case 1:  // electron
-                ev.add_electron(obj);
-                break;
-            case 2:  // muon
-                ev.add_muon(obj);
-                break;
-            case 3:  // tau
-                ev.add_tau(obj);
-                break;
-            case 4:
-                if (obj.btag > 0.5) {  // b-jet
-                    ev.add_bjet(obj);
-                } else {  // normal jet
-                    ev.add_jet(obj);
-                }
-                break;
-            default:  // missing energy
-                ev.set_met(obj);
-                break;
+Event parseEvent(std::istream *is) { return mkEvent(parseRawEvent(is)); }
+
+// Adds the objects to the event according to their types.
+void dispatchObjects(const Objects &objs, Event *ev) {
+    LHCO_STAT_TIMER(Dispatch);
+    std::uint64_t num[7] = {0, 0, 0, 0, 0, 0, 0};
+    for (const auto &obj : objs) {
+        switch (obj.typ) {
+        case 0:  // photon
+            ev->add_photon(obj);
+            ++num[0];
+            break;
+        case 1:  // electron
+            ev->add_electron(obj);
+            ++num[1];
+            break;
+        case 2:  // muon
+            ev->add_muon(obj);
+            ++num[2];
+            break;
+        case 3:  // tau
+            ev->add_tau(obj);
+            ++num[3];
+            break;
+        case 4:
+            if (obj.btag > 0.5) {  // b-jet
+                ev->add_bjet(obj);
+                ++num[5];
+            } else {  // normal jet
+                ev->add_jet(obj);
+                ++num[4];
             }
+            break;
+        default:  // missing energy
+            ev->set_met(obj);
+            ++num[6];
+            break;
         }
-        ev.sort_particles();
     }
+    LHCO_STAT_ADD(Photons, num[0]);
+    LHCO_STAT_ADD(Electrons, num[1]);
+    LHCO_STAT_ADD(Muons, num[2]);
+    LHCO_STAT_ADD(Taus, num[3]);
+    LHCO_STAT_ADD(Jets, num[4]);
+    LHCO_STAT_ADD(BJets, num[5]);
+    LHCO_STAT_ADD(MissingETs, num[6]);
+}
+
+Event mkEvent(const RawEvent &raw_ev) {
+    Event ev;
+    mkEvent(raw_ev, &ev);
     return ev;
 }
+
+void mkEvent(const RawEvent &raw_ev, Event *ev) {
+    ev->clear();
+    if (!raw_ev.empty()) {
+        dispatchObjects(raw_ev.objects(), ev);
+        ev->sort_particles();
+    }
+}
 }  // namespace lhco
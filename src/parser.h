@@ -9,6 +9,15 @@ namespace lhco {
 RawEvent parseRawEvent(std::istream *is);
 
 Event parseEvent(std::istream *is);
+
+Event mkEvent(const RawEvent &raw_ev);
+
+/*
+ * Same as mkEvent, but fills *ev in place, so that the storage of its
+ * particles is reused from one event to the next. The particles are sorted
+ * in the sort mode of *ev.
+ */
+void mkEvent(const RawEvent &raw_ev, Event *ev);
 }  // namespace lhco
 
 #endif  // SRC_PARSER_H_
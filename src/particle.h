@@ -9,25 +9,43 @@
 #include "kinematics.h"
 
 namespace lhco {
+/*
+ * When the Cartesian momentum and the energy of a particle are computed.
+ * Eager computes them once in the constructor. Lazy keeps only pt, eta, phi
+ * and mass, and computes them with the same formulas each time they are
+ * asked for, so that the particles failing cuts on pt and eta never pay for
+ * the cos, sin, sinh and sqrt. Neither modifies the particle after it is
+ * built, and both give the same values.
+ */
+enum class Kinematics { Eager, Lazy };
+
 class Particle {
 private:
     double pt_ = 0.0;
     double phi_ = 0.0;
     double px_ = 0.0;
     double py_ = 0.0;
+    bool lazy_ = false;
 
 public:
     Particle() {}
-    Particle(const Pt &pt, const Phi &phi) : pt_(pt.value), phi_(phi.value) {
-        px_ = pt.value * std::cos(phi.value);
-        py_ = pt.value * std::sin(phi.value);
+    Particle(const Pt &pt, const Phi &phi,
+             Kinematics kinematics = Kinematics::Eager)
+        : pt_(pt.value),
+          phi_(phi.value),
+          lazy_(kinematics == Kinematics::Lazy) {
+        if (!lazy_) {
+            px_ = pt.value * std::cos(phi.value);
+            py_ = pt.value * std::sin(phi.value);
+        }
     }
     virtual ~Particle() {}
 
     double pt() const { return pt_; }
     double phi() const { return phi_; }
-    double px() const { return px_; }
-    double py() const { return py_; }
+    double px() const { return lazy_ ? pt_ * std::cos(phi_) : px_; }
+    double py() const { return lazy_ ? pt_ * std::sin(phi_) : py_; }
+    bool lazy() const { return lazy_; }
 
     virtual std::string show() const = 0;
 };
@@ -45,20 +63,23 @@ public:
     enum class Charge { Positive, Negative, Neutral };
 
 private:
+    // First, so that it fits in the padding after Particle.
+    Charge q_ = Charge::Neutral;
     double eta_ = 0.0;
     double m_ = 0.0;
     double pz_ = 0.0;
     double e_ = 0.0;
-    Charge q_ = Charge::Neutral;
 
-protected:
-    void set_energy(double m) {
+    static double energyOf(double pt, double pz, double m) {
         if (m > 0.0) {
-            e_ = std::sqrt(pt() * pt() + pz_ * pz_ + m * m);
+            return std::sqrt(pt * pt + pz * pz + m * m);
         } else {
-            e_ = std::sqrt(pt() * pt() + pz_ * pz_);
+            return std::sqrt(pt * pt + pz * pz);
         }
     }
+
+protected:
+    void set_energy(double m) { e_ = energyOf(pt(), pz_, m); }
     void set_charge(int q) {
         if (q > 0) {
             q_ = Charge::Positive;
@@ -71,10 +92,13 @@ protected:
 
 public:
     Visible() {}
-    Visible(const Pt &pt, const Eta &eta, const Phi &phi, const Mass &m)
-        : Particle(pt, phi), eta_(eta.value), m_(m.value) {
-        pz_ = pt.value * std::sinh(eta.value);
-        set_energy(m.value);
+    Visible(const Pt &pt, const Eta &eta, const Phi &phi, const Mass &m,
+            Kinematics kinematics = Kinematics::Eager)
+        : Particle(pt, phi, kinematics), eta_(eta.value), m_(m.value) {
+        if (!lazy()) {
+            pz_ = pt.value * std::sinh(eta.value);
+            set_energy(m.value);
+        }
     }
     Visible(const Energy &e, const Px &px, const Py &py, const Pz &pz)
         : Particle(Pt(px, py), Phi(px, py)), pz_(pz.value), e_(e.value) {
@@ -83,18 +107,18 @@ public:
         m_ = invariantMass(e, px, py, pz);
     }
     Visible(const Pt &pt, const Eta &eta, const Phi &phi, const Mass &m,
-            const int &ntrk)
-        : Particle(pt, phi), eta_(eta.value), m_(m.value) {
-        pz_ = pt.value * std::sinh(eta.value);
-        set_energy(m.value);
+            const int &ntrk, Kinematics kinematics = Kinematics::Eager)
+        : Visible(pt, eta, phi, m, kinematics) {
         set_charge(ntrk);
     }
     virtual ~Visible() {}
 
     double eta() const { return eta_; }
     double mass() const { return m_; }
-    double pz() const { return pz_; }
-    double energy() const { return e_; }
+    double pz() const { return lazy() ? pt() * std::sinh(eta_) : pz_; }
+    double energy() const {
+        return lazy() ? energyOf(pt(), pz(), m_) : e_;
+    }
     int charge() const {
         switch (q_) {
         case Charge::Positive:
@@ -113,6 +137,11 @@ public:
     friend bool operator>(const Visible &lhs, const Visible &rhs) {
         return rhs < lhs;
     }
+    /*
+     * The sum is a new Visible, whose eta, phi and mass are derived from
+     * (E, px, py, pz) at every addition. LorentzSum in kinematics.h adds up
+     * many particles without it.
+     */
     Visible &operator+=(const Visible &rhs);
     friend Visible operator+(Visible lhs, const Visible &rhs) {
         return lhs += rhs;
@@ -124,8 +153,9 @@ using Visibles = std::vector<Visible>;
 class Photon : public Visible {
 public:
     Photon() {}
-    Photon(const Pt &pt, const Eta &eta, const Phi &phi, const Mass &m)
-        : Visible(pt, eta, phi, m) {}
+    Photon(const Pt &pt, const Eta &eta, const Phi &phi, const Mass &m,
+           Kinematics kinematics = Kinematics::Eager)
+        : Visible(pt, eta, phi, m, kinematics) {}
     ~Photon() {}
 
     std::string show() const;
@@ -134,8 +164,8 @@ public:
 struct Electron : public Visible {
     Electron() {}
     Electron(const Pt &pt, const Eta &eta, const Phi &phi, const Mass &m,
-             int ntrk)
-        : Visible(pt, eta, phi, m, ntrk) {}
+             int ntrk, Kinematics kinematics = Kinematics::Eager)
+        : Visible(pt, eta, phi, m, ntrk, kinematics) {}
     ~Electron() {}
 
     std::string show() const;
@@ -155,8 +185,9 @@ protected:
 public:
     Muon() {}
     Muon(const Pt &pt, const Eta &eta, const Phi &phi, const Mass &m,
-         const int &ntrk, const double &hadem)
-        : Visible(pt, eta, phi, m, ntrk) {
+         const int &ntrk, const double &hadem,
+         Kinematics kinematics = Kinematics::Eager)
+        : Visible(pt, eta, phi, m, ntrk, kinematics) {
         set_ptiso_etrat(hadem);
     }
     ~Muon() {}
@@ -186,8 +217,8 @@ protected:
 public:
     Tau() {}
     Tau(const Pt &pt, const Eta &eta, const Phi &phi, const Mass &m,
-        const int &ntrk)
-        : Visible(pt, eta, phi, m) {
+        const int &ntrk, Kinematics kinematics = Kinematics::Eager)
+        : Visible(pt, eta, phi, m, kinematics) {
         ntrk > 0 ? set_charge(1) : set_charge(-1);
         set_prong(ntrk);
     }
@@ -205,8 +236,8 @@ private:
 public:
     Jet() {}
     Jet(const Pt &pt, const Eta &eta, const Phi &phi, const Mass &m,
-        const int &ntrk)
-        : Visible(pt, eta, phi, m), num_track_(ntrk) {}
+        const int &ntrk, Kinematics kinematics = Kinematics::Eager)
+        : Visible(pt, eta, phi, m, kinematics), num_track_(ntrk) {}
     virtual ~Jet() {}
 
     int num_track() const { return num_track_; }
@@ -224,8 +255,9 @@ private:
 public:
     Bjet() {}
     Bjet(const Pt &pt, const Eta &eta, const Phi &phi, const Mass &m,
-         const int &ntrk, const int &btag)
-        : Jet(pt, eta, phi, m, ntrk) {
+         const int &ntrk, const int &btag,
+         Kinematics kinematics = Kinematics::Eager)
+        : Jet(pt, eta, phi, m, ntrk, kinematics) {
         btag < 1.5 ? btag_ = BTag::Loose : btag_ = BTag::Tight;
     }
     ~Bjet() {}
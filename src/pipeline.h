@@ -0,0 +1,254 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#ifndef SRC_PIPELINE_H_
+#define SRC_PIPELINE_H_
+
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "event.h"
+#include "parallel.h"
+#include "parser.h"
+#include "reader.h"
+#include "spsc_queue.h"
+
+namespace lhco {
+/*
+ * Event loop in three stages running concurrently: a reader thread parses
+ * the events, num_workers threads call the analysis on each of them, and the
+ * calling thread passes the results to the sink. The stages are connected by
+ * bounded lock-free queues of queue_size entries.
+ *
+ * The events are dealt to the workers in turn. If ordered is true, the sink
+ * receives the results in the input order. Otherwise it takes them as soon as
+ * any worker is done.
+ *
+ * If the source, the analysis, or the sink throws, the stages stop, all the
+ * threads are joined, and run() rethrows the first exception.
+ */
+template <typename Result>
+class EventPipeline {
+public:
+    using Analysis = std::function<Result(const Event &)>;
+    using Sink = std::function<void(Result &&)>;
+
+private:
+    unsigned num_workers_;
+    std::size_t queue_size_;
+    bool ordered_;
+
+    struct Output {
+        bool done = false;
+        Result result;
+    };
+
+public:
+    explicit EventPipeline(unsigned num_workers = 0,
+                           std::size_t queue_size = 256, bool ordered = true)
+        : num_workers_(num_workers > 0 ? num_workers : defaultNumThreads()),
+          queue_size_(queue_size > 0 ? queue_size : 1),
+          ordered_(ordered) {}
+
+    unsigned num_workers() const { return num_workers_; }
+    bool ordered() const { return ordered_; }
+
+    /*
+     * Runs the pipeline until next_event() returns an empty event, and
+     * returns the number of events analyzed.
+     */
+    template <typename Source>
+    std::size_t run(Source next_event, Analysis analysis, Sink sink) const;
+
+    std::size_t run(std::istream *is, Analysis analysis, Sink sink) const {
+        return run([is]() { return parseEvent(is); }, analysis, sink);
+    }
+
+    std::size_t run(Reader *reader, Analysis analysis, Sink sink) const {
+        return run([reader]() { return reader->next_event(); }, analysis,
+                   sink);
+    }
+};
+
+template <typename Result>
+template <typename Source>
+std::size_t EventPipeline<Result>::run(Source next_event, Analysis analysis,
+                                       Sink sink) const {
+    std::vector<std::unique_ptr<SpscQueue<Event>>> inputs;
+    std::vector<std::unique_ptr<SpscQueue<Output>>> outputs;
+    for (unsigned i = 0; i < num_workers_; ++i) {
+        inputs.emplace_back(new SpscQueue<Event>(queue_size_));
+        outputs.emplace_back(new SpscQueue<Output>(queue_size_));
+    }
+
+    FirstError error;
+    std::size_t num_events = 0;
+    std::thread reader([&]() {
+        unsigned w = 0;
+        try {
+            while (!error.stopped()) {
+                Event ev = next_event();
+                if (ev.empty()) { break; }
+                inputs[w]->push(std::move(ev));
+                ++num_events;
+                if (++w == num_workers_) { w = 0; }
+            }
+        } catch (...) {
+            error.capture();
+        }
+        // An empty event tells the workers that the input is over.
+        for (unsigned i = 0; i < num_workers_; ++i) {
+            inputs[w]->push(Event());
+            if (++w == num_workers_) { w = 0; }
+        }
+    });
+
+    // After an error, the workers and the sink drain their queues without
+    // calling the analysis and the sink, so that every thread can finish.
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < num_workers_; ++i) {
+        workers.emplace_back([&, i]() {
+            Event ev;
+            for (inputs[i]->pop(&ev); !ev.empty(); inputs[i]->pop(&ev)) {
+                if (error.stopped()) { continue; }
+                Output out;
+                try {
+                    out.result = analysis(ev);
+                } catch (...) {
+                    error.capture();
+                    continue;
+                }
+                outputs[i]->push(std::move(out));
+            }
+            Output end;
+            end.done = true;
+            outputs[i]->push(std::move(end));
+        });
+    }
+
+    auto consume = [&](Output *out) {
+        if (error.stopped()) { return; }
+        try {
+            sink(std::move(out->result));
+        } catch (...) {
+            error.capture();
+        }
+    };
+    std::vector<char> done(num_workers_, 0);
+    Output out;
+    if (ordered_) {
+        for (unsigned w = 0;; w = w + 1 == num_workers_ ? 0 : w + 1) {
+            outputs[w]->pop(&out);
+            if (out.done) {
+                done[w] = 1;
+                break;
+            }
+            consume(&out);
+        }
+    } else {
+        for (unsigned num_done = 0; num_done < num_workers_;) {
+            bool idle = true;
+            for (unsigned w = 0; w < num_workers_; ++w) {
+                while (!done[w] && outputs[w]->try_pop(&out)) {
+                    idle = false;
+                    if (out.done) {
+                        done[w] = 1;
+                        ++num_done;
+                        break;
+                    }
+                    consume(&out);
+                }
+            }
+            if (idle) { std::this_thread::yield(); }
+        }
+    }
+    // The order of the results is lost after an error, so the other
+    // workers may still have results before their end.
+    for (unsigned w = 0; w < num_workers_; ++w) {
+        while (!done[w]) {
+            outputs[w]->pop(&out);
+            done[w] = out.done;
+        }
+    }
+
+    reader.join();
+    for (auto &t : workers) { t.join(); }
+    error.rethrow();
+    return num_events;
+}
+
+/*
+ * Calls visit(ev, worker) for every event from next_event() on num_workers
+ * threads, with worker in [0, num_workers). Event i always goes to worker
+ * i % num_workers, so that per-worker accumulators such as the shards of
+ * HistogramShards see the same events in the same order from run to run.
+ * Returns the number of events. The first exception thrown by next_event() or
+ * visit() is rethrown once all the workers have finished.
+ */
+template <typename Source, typename Visit>
+std::size_t forEachEvent(Source next_event, Visit visit,
+                         unsigned num_workers = 0,
+                         std::size_t queue_size = 256) {
+    if (num_workers == 0) { num_workers = defaultNumThreads(); }
+    if (queue_size == 0) { queue_size = 1; }
+    std::vector<std::unique_ptr<SpscQueue<Event>>> inputs;
+    for (unsigned i = 0; i < num_workers; ++i) {
+        inputs.emplace_back(new SpscQueue<Event>(queue_size));
+    }
+
+    FirstError error;
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < num_workers; ++i) {
+        workers.emplace_back([&, i]() {
+            Event ev;
+            for (inputs[i]->pop(&ev); !ev.empty(); inputs[i]->pop(&ev)) {
+                if (error.stopped()) { continue; }
+                try {
+                    visit(static_cast<const Event &>(ev), i);
+                } catch (...) {
+                    error.capture();
+                }
+            }
+        });
+    }
+
+    std::size_t num_events = 0;
+    unsigned w = 0;
+    try {
+        while (!error.stopped()) {
+            Event ev = next_event();
+            if (ev.empty()) { break; }
+            inputs[w]->push(std::move(ev));
+            ++num_events;
+            if (++w == num_workers) { w = 0; }
+        }
+    } catch (...) {
+        error.capture();
+    }
+    for (auto &input : inputs) { input->push(Event()); }
+    for (auto &t : workers) { t.join(); }
+    error.rethrow();
+    return num_events;
+}
+
+template <typename Visit>
+std::size_t forEachEvent(std::istream *is, Visit visit,
+                         unsigned num_workers = 0,
+                         std::size_t queue_size = 256) {
+    return forEachEvent([is]() { return parseEvent(is); }, visit,
+                        num_workers, queue_size);
+}
+
+template <typename Visit>
+std::size_t forEachEvent(Reader *reader, Visit visit,
+                         unsigned num_workers = 0,
+                         std::size_t queue_size = 256) {
+    return forEachEvent([reader]() { return reader->next_event(); }, visit,
+                        num_workers, queue_size);
+}
+}  // namespace lhco
+
+#endif  // SRC_PIPELINE_H_
@@ -0,0 +1,162 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#include "reader.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif  // HAVE_CONFIG_H
+#include "input_stream.h"
+#include "object.h"
+#include "parser.h"
+#include "scanner.h"
+#include "stats.h"
+
+namespace lhco {
+void readObject(Scanner *in, Object *obj) {
+    double ntrk = 0.0, btag = 0.0;
+    *in >> obj->eta >> obj->phi >> obj->pt >> obj->jmass >> ntrk >> btag >>
+        obj->hadem;
+    obj->ntrk = static_cast<int>(ntrk);
+    obj->btag = static_cast<int>(btag);
+}
+
+ParseStatus parseRawEvent(const char **first, const char *last,
+                          RawEvent *lhco) {
+    LHCO_STAT_TIMER(Parse);
+    Header header;
+    const char *pos = *first;
+    std::uint64_t num_lines = 0, num_comments = 0;
+    ParseStatus status = ParseStatus::Incomplete;
+    lhco->clear();
+
+    while (pos < last) {
+        const char *line = pos;
+        const char *eol = endOfLine(line, last);
+        pos = eol == last ? last : eol + 1;
+        ++num_lines;
+        if (isCommentLine(line, eol)) {
+            ++num_comments;
+            continue;
+        }
+
+        Scanner in(line, eol);
+        int first_digit = 0, second_digit = 0;
+        in >> first_digit >> second_digit;
+        if (first_digit == 0) {  // line for event header
+            header.event_number = second_digit;
+            in >> header.trigger_word;
+        } else if (second_digit <= 6) {
+            Object obj;
+            obj.typ = second_digit;
+            readObject(&in, &obj);
+            lhco->add_object(obj);
+            if (second_digit == 6) {  // line for missing energy
+                lhco->set_header(header);
+                (*lhco)(EventStatus::Fill);
+                status = ParseStatus::Complete;
+                LHCO_STAT_ADD(Events, 1);
+                break;
+            }
+        } else {  // undefined line
+            status = ParseStatus::Undefined;
+            LHCO_STAT_ADD(UndefinedLines, 1);
+            break;
+        }
+    }
+
+    if (status != ParseStatus::Complete) { lhco->clear(); }
+    LHCO_STAT_ADD(BytesRead, pos - *first);
+    LHCO_STAT_ADD(Lines, num_lines);
+    LHCO_STAT_ADD(CommentLines, num_comments);
+    *first = pos;
+    return status;
+}
+
+std::size_t skipEvents(const char **first, const char *last, std::size_t n,
+                       ParseStatus *status) {
+    ParseStatus result = ParseStatus::Complete;
+    std::size_t num_events = 0;
+    const char *event_begin = *first;
+    for (const char *pos = *first; num_events < n;) {
+        if (pos == last) {
+            result = ParseStatus::Incomplete;
+            break;
+        }
+        const char *line = pos;
+        const char *eol = endOfLine(line, last);
+        pos = eol == last ? last : eol + 1;
+
+        Scanner in(line, eol);
+        int first_digit = 0, second_digit = 0;
+        in >> first_digit >> second_digit;
+        // Only the lines ending an event or the input can change the count,
+        // so the other lines are not searched for '#'.
+        if (first_digit == 0 || second_digit < 6 ||
+            isCommentLine(line, eol)) {
+            continue;
+        }
+        if (second_digit > 6) {  // undefined line
+            result = ParseStatus::Undefined;
+            break;
+        }
+        ++num_events;  // line for missing energy
+        event_begin = pos;
+    }
+
+    *first = event_begin;
+    if (status != nullptr) { *status = result; }
+    return num_events;
+}
+
+std::size_t countEvents(const char *first, const char *last) {
+    return skipEvents(&first, last, std::numeric_limits<std::size_t>::max());
+}
+
+std::size_t countEvents(const std::string &filename) {
+    MappedFile file(filename);
+    if (isGzip(file.begin(), file.end())) { return 0; }
+    return countEvents(file.begin(), file.end());
+}
+
+bool Reader::open(const std::string &filename) {
+    file_.open(filename);
+    if (isGzip(file_.begin(), file_.end())) { file_.close(); }
+    pos_ = file_.begin();
+    return file_.is_open();
+}
+
+RawEvent Reader::next_raw_event() {
+    RawEvent lhco;
+    if (pos_ != nullptr) { parseRawEvent(&pos_, file_.end(), &lhco); }
+    return lhco;
+}
+
+Event Reader::next_event() { return mkEvent(next_raw_event()); }
+
+std::size_t Reader::skip_events(std::size_t n) {
+    if (pos_ == nullptr) { return 0; }
+    return skipEvents(&pos_, file_.end(), n);
+}
+
+std::size_t Reader::count_events() const {
+    if (pos_ == nullptr) { return 0; }
+    return countEvents(pos_, file_.end());
+}
+
+bool Reader::next_raw_event(RawEvent *ev) {
+    if (pos_ == nullptr) {
+        ev->clear();
+        return false;
+    }
+    return parseRawEvent(&pos_, file_.end(), ev) == ParseStatus::Complete;
+}
+
+bool Reader::next_event(Event *ev) {
+    const bool ok = next_raw_event(&raw_);
+    mkEvent(raw_, ev);
+    return ok;
+}
+}  // namespace lhco
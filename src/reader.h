@@ -0,0 +1,163 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#ifndef SRC_READER_H_
+#define SRC_READER_H_
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include "event.h"
+#include "mapped_file.h"
+
+namespace lhco {
+enum class ParseStatus { Complete, Undefined, Incomplete };
+
+/*
+ * Parses the event starting at *first in the buffer [*first, last) following
+ * the same rules as parseRawEvent(std::istream *), and moves *first past the
+ * lines consumed. The event is filled only if the status is Complete, and
+ * left empty otherwise. Its storage is reused, so that parsing into the same
+ * RawEvent again does not allocate once it is large enough. Undefined means
+ * that an unknown record was met, and Incomplete that the buffer ended
+ * before the line for missing energy.
+ */
+ParseStatus parseRawEvent(const char **first, const char *last,
+                          RawEvent *lhco);
+
+/*
+ * Moves *first past the next n events in [*first, last) without parsing
+ * them, and returns the number of events skipped. Only the first two fields
+ * of each line are read, and comment lines and undefined records are
+ * treated as in parseRawEvent. *first is left at the start of the event
+ * following the last one skipped. If status is given, it is set to Complete
+ * if n events were skipped, Undefined if an undefined record was met, and
+ * Incomplete if the buffer ended.
+ */
+std::size_t skipEvents(const char **first, const char *last, std::size_t n,
+                       ParseStatus *status = nullptr);
+
+// The number of events that the loop over parseRawEvent would return.
+std::size_t countEvents(const char *first, const char *last);
+
+// Zero for gzip-compressed files, which cannot be scanned in place.
+std::size_t countEvents(const std::string &filename);
+
+/*
+ * Reads events from a memory-mapped LHCO file without going through
+ * iostreams. It returns the same events as parseRawEvent and parseEvent.
+ * Gzip-compressed files are not opened: read them with InputStream.
+ */
+class Reader {
+private:
+    MappedFile file_;
+    const char *pos_ = nullptr;
+    RawEvent raw_;
+
+public:
+    Reader() {}
+    explicit Reader(const std::string &filename) { open(filename); }
+
+    bool open(const std::string &filename);
+    bool is_open() const { return file_.is_open(); }
+    void close() {
+        file_.close();
+        pos_ = nullptr;
+    }
+
+    RawEvent next_raw_event();
+    Event next_event();
+    /*
+     * Parse the next event into *ev, reusing its storage, and return false
+     * at the end of the events. They do not allocate once the buffers have
+     * grown to the largest event.
+     */
+    bool next_raw_event(RawEvent *ev);
+    bool next_event(Event *ev);
+
+    // Skips the next n events and returns the number of events skipped.
+    std::size_t skip_events(std::size_t n);
+    // The number of events left from the current position.
+    std::size_t count_events() const;
+
+    const char *data() const { return file_.begin(); }
+    std::size_t size() const { return file_.size(); }
+    std::size_t offset() const { return pos_ - file_.begin(); }
+    // Moves to the given byte offset, which should be the start of an event.
+    void seek(std::size_t offset) {
+        if (file_.is_open()) {
+            pos_ = file_.begin() + (offset < size() ? offset : size());
+        }
+    }
+};
+
+/*
+ * Iterates over the events of a file with a range-based for loop:
+ *
+ *     for (const lhco::Event &ev : lhco::EventReader(filename)) { ... }
+ *
+ * All the events are parsed into the same Event, so the reference is valid
+ * only until the iterator is incremented. It is not const, so that the
+ * collections can be read with Event::sorted_jet() and the like in the Lazy
+ * sort mode.
+ */
+class EventReader {
+private:
+    Reader reader_;
+    Event event_;
+
+public:
+    class iterator {
+    private:
+        EventReader *reader_;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Event;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Event *;
+        using reference = Event &;
+
+        explicit iterator(EventReader *reader = nullptr) : reader_(reader) {}
+
+        reference operator*() const { return reader_->event(); }
+        pointer operator->() const { return &reader_->event(); }
+        iterator &operator++() {
+            if (!reader_->next()) { reader_ = nullptr; }
+            return *this;
+        }
+        bool operator==(const iterator &other) const {
+            return reader_ == other.reader_;
+        }
+        bool operator!=(const iterator &other) const {
+            return reader_ != other.reader_;
+        }
+    };
+
+    EventReader() {}
+    explicit EventReader(const std::string &filename) : reader_(filename) {}
+
+    bool open(const std::string &filename) { return reader_.open(filename); }
+    bool is_open() const { return reader_.is_open(); }
+    void close() { reader_.close(); }
+
+    // Sorts the particles of the events as given by the mode.
+    void set_sort_mode(SortMode mode, std::size_t num_leading = 4) {
+        event_.set_sort_mode(mode, num_leading);
+    }
+    // Computes the momenta of the particles as given by the kinematics.
+    void set_kinematics(Kinematics kinematics) {
+        event_.set_kinematics(kinematics);
+    }
+
+    bool next() { return reader_.next_event(&event_); }
+    const Event &event() const { return event_; }
+    Event &event() { return event_; }
+    Reader &reader() { return reader_; }
+
+    // Starts from the current position of the reader.
+    iterator begin() { return next() ? iterator(this) : iterator(); }
+    iterator end() { return iterator(); }
+};
+}  // namespace lhco
+
+#endif  // SRC_READER_H_
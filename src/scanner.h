@@ -0,0 +1,167 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#ifndef SRC_SCANNER_H_
+#define SRC_SCANNER_H_
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <locale>
+#include <sstream>
+#include <string>
+
+namespace lhco {
+inline bool isSpace(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+// Returns the position of the newline ending the line at pos, or last.
+inline const char *endOfLine(const char *pos, const char *last) {
+    const void *eol = std::memchr(pos, '\n', last - pos);
+    return eol == nullptr ? last : static_cast<const char *>(eol);
+}
+
+// Any line containing '#' is a comment line.
+inline bool isCommentLine(const char *line, const char *eol) {
+    return std::memchr(line, '#', eol - line) != nullptr;
+}
+
+/*
+ * Locale-free reader of the numeric fields in a single line [first, last).
+ *
+ * It mimics the formatted extraction of std::istringstream in the "C"
+ * locale: once an extraction fails, all the following ones are no-ops, and
+ * a failed conversion stores zero unless the line has already ended.
+ */
+class Scanner {
+private:
+    const char *pos_;
+    const char *last_;
+    bool fail_ = false;
+
+    static const double *powersOfTen() {
+        static const double pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                       1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                       1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                       1e18, 1e19, 1e20, 1e21, 1e22};
+        return pow10;
+    }
+
+    bool skip_spaces() {
+        while (pos_ < last_ && isSpace(*pos_)) { ++pos_; }
+        if (pos_ == last_) { fail_ = true; }
+        return !fail_;
+    }
+
+    // Rare inputs (too many digits, huge exponents) go through the stream.
+    double slow_double(const char *first) const {
+        std::istringstream iss(std::string(first, pos_));
+        iss.imbue(std::locale::classic());
+        double v = 0.0;
+        iss >> v;
+        return v;
+    }
+
+public:
+    Scanner(const char *first, const char *last) : pos_(first), last_(last) {}
+
+    bool fail() const { return fail_; }
+    const char *position() const { return pos_; }
+
+    Scanner &operator>>(int &v) {
+        if (fail_ || !skip_spaces()) { return *this; }
+        bool negative = false;
+        if (*pos_ == '-' || *pos_ == '+') { negative = *pos_++ == '-'; }
+        const char *digits = pos_;
+        std::int64_t n = 0;
+        for (; pos_ < last_ && isDigit(*pos_); ++pos_) {
+            if (n <= INT_MAX) { n = n * 10 + (*pos_ - '0'); }
+        }
+        if (pos_ == digits) {
+            fail_ = true;
+            v = 0;
+            return *this;
+        }
+        if (negative) { n = -n; }
+        if (n > INT_MAX) {
+            fail_ = true;
+            v = INT_MAX;
+        } else if (n < INT_MIN) {
+            fail_ = true;
+            v = INT_MIN;
+        } else {
+            v = static_cast<int>(n);
+        }
+        return *this;
+    }
+
+    Scanner &operator>>(double &v) {
+        if (fail_ || !skip_spaces()) { return *this; }
+        const char *first = pos_;
+        bool negative = false;
+        if (*pos_ == '-' || *pos_ == '+') { negative = *pos_++ == '-'; }
+
+        std::uint64_t mantissa = 0;
+        int num_digits = 0, num_significant = 0, exponent = 0;
+        for (; pos_ < last_ && isDigit(*pos_); ++pos_, ++num_digits) {
+            if (num_significant < 19) {
+                mantissa = mantissa * 10 + (*pos_ - '0');
+                if (mantissa > 0) { ++num_significant; }
+            } else {
+                ++exponent;
+            }
+        }
+        if (pos_ < last_ && *pos_ == '.') {
+            for (++pos_; pos_ < last_ && isDigit(*pos_); ++pos_, ++num_digits) {
+                if (num_significant < 19) {
+                    mantissa = mantissa * 10 + (*pos_ - '0');
+                    if (mantissa > 0) { ++num_significant; }
+                    --exponent;
+                }
+            }
+        }
+        if (num_digits == 0) {
+            fail_ = true;
+            v = 0.0;
+            return *this;
+        }
+        if (pos_ < last_ && (*pos_ == 'e' || *pos_ == 'E')) {
+            ++pos_;
+            bool negative_exp = false;
+            if (pos_ < last_ && (*pos_ == '-' || *pos_ == '+')) {
+                negative_exp = *pos_++ == '-';
+            }
+            if (pos_ == last_ || !isDigit(*pos_)) {
+                fail_ = true;
+                v = 0.0;
+                return *this;
+            }
+            int e = 0;
+            for (; pos_ < last_ && isDigit(*pos_); ++pos_) {
+                if (e < 100000) { e = e * 10 + (*pos_ - '0'); }
+            }
+            exponent += negative_exp ? -e : e;
+        }
+
+        // Exact when both the mantissa and the power of ten are exactly
+        // representable, which covers every field written in LHCO files.
+        if (mantissa < (std::uint64_t(1) << 53) && exponent >= -22 &&
+            exponent <= 22) {
+            double d = static_cast<double>(mantissa);
+            if (exponent < 0) {
+                d /= powersOfTen()[-exponent];
+            } else {
+                d *= powersOfTen()[exponent];
+            }
+            v = negative ? -d : d;
+        } else {
+            v = slow_double(first);
+        }
+        return *this;
+    }
+};
+}  // namespace lhco
+
+#endif  // SRC_SCANNER_H_
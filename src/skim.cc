@@ -0,0 +1,54 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#include "skim.h"
+#include "scanner.h"
+
+namespace lhco {
+void VerbatimWriter::write_run() {
+    const std::size_t size = run_last_ - run_first_;
+    if (size == 0) { return; }
+    if (size >= buffer_size_) {
+        // Large runs go straight from the input to the stream.
+        if (!buffer_.empty()) {
+            os_->write(buffer_.data(), buffer_.size());
+            buffer_.clear();
+        }
+        os_->write(run_first_, size);
+    } else {
+        buffer_.append(run_first_, size);
+        if (buffer_.size() >= buffer_size_) {
+            os_->write(buffer_.data(), buffer_.size());
+            buffer_.clear();
+        }
+    }
+    num_bytes_ += size;
+    run_first_ = run_last_ = nullptr;
+}
+
+void VerbatimWriter::write(const char *first, const char *last) {
+    if (first == last) { return; }
+    if (first != run_last_) {
+        write_run();
+        run_first_ = first;
+    }
+    run_last_ = last;
+}
+
+void VerbatimWriter::flush() {
+    write_run();
+    if (!buffer_.empty()) {
+        os_->write(buffer_.data(), buffer_.size());
+        buffer_.clear();
+    }
+}
+
+const char *endOfPreamble(const char *first, const char *last) {
+    const char *pos = first;
+    while (pos < last) {
+        const char *eol = endOfLine(pos, last);
+        if (!isCommentLine(pos, eol)) { break; }
+        pos = eol == last ? last : eol + 1;
+    }
+    return pos;
+}
+}  // namespace lhco
@@ -0,0 +1,105 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#ifndef SRC_SKIM_H_
+#define SRC_SKIM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include "event.h"
+#include "parser.h"
+#include "reader.h"
+
+namespace lhco {
+/*
+ * Copies byte ranges of an input buffer to a stream. Adjacent ranges are
+ * joined, and short ones are gathered in a buffer, so that the stream only
+ * sees large writes. The input must stay mapped until flush() is called.
+ */
+class VerbatimWriter {
+private:
+    std::ostream *os_;
+    std::size_t buffer_size_;
+    std::string buffer_;
+    const char *run_first_ = nullptr;
+    const char *run_last_ = nullptr;
+    std::uint64_t num_bytes_ = 0;
+
+    void write_run();
+
+public:
+    static const std::size_t kDefaultBufferSize = 4 << 20;
+
+    explicit VerbatimWriter(std::ostream *os,
+                            std::size_t buffer_size = kDefaultBufferSize)
+        : os_(os), buffer_size_(buffer_size) {
+        buffer_.reserve(buffer_size_);
+    }
+    ~VerbatimWriter() { flush(); }
+    VerbatimWriter(const VerbatimWriter &) = delete;
+    VerbatimWriter &operator=(const VerbatimWriter &) = delete;
+
+    void write(const char *first, const char *last);
+    void flush();
+    std::uint64_t num_bytes() const { return num_bytes_; }
+};
+
+struct SkimResult {
+    std::size_t num_events = 0;  // events read
+    std::size_t num_kept = 0;
+    std::uint64_t num_bytes = 0;  // bytes written
+};
+
+// The end of the comment lines at the beginning of [first, last).
+const char *endOfPreamble(const char *first, const char *last);
+
+/*
+ * Writes the events in [first, last) for which keep(raw_event) is true to
+ * the stream, copying their original bytes instead of formatting them. The
+ * comment lines at the beginning and at the end of the input are always
+ * copied, and the comment lines between two events go with the following
+ * event. Reading stops at the first event that cannot be parsed, as in the
+ * loop over parseRawEvent, and nothing after it is copied.
+ */
+template <typename Keep>
+SkimResult skimRawEvents(const char *first, const char *last, Keep keep,
+                         std::ostream *os) {
+    SkimResult result;
+    VerbatimWriter out(os);
+    const char *pos = endOfPreamble(first, last);
+    out.write(first, pos);
+
+    RawEvent raw;
+    const char *event_begin = pos;
+    for (; parseRawEvent(&pos, last, &raw) == ParseStatus::Complete;
+         event_begin = pos) {
+        ++result.num_events;
+        if (keep(static_cast<const RawEvent &>(raw))) {
+            out.write(event_begin, pos);
+            ++result.num_kept;
+        }
+    }
+    if (endOfPreamble(event_begin, last) == last) {
+        out.write(event_begin, last);
+    }
+    out.flush();
+    result.num_bytes = out.num_bytes();
+    return result;
+}
+
+// The same, with keep(event) taking the event made by mkEvent.
+template <typename Keep>
+SkimResult skimEvents(const char *first, const char *last, Keep keep,
+                      std::ostream *os) {
+    Event ev;
+    return skimRawEvents(first, last,
+                         [&](const RawEvent &raw) {
+                             mkEvent(raw, &ev);
+                             return keep(static_cast<const Event &>(ev));
+                         },
+                         os);
+}
+}  // namespace lhco
+
+#endif  // SRC_SKIM_H_
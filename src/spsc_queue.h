@@ -0,0 +1,64 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#ifndef SRC_SPSC_QUEUE_H_
+#define SRC_SPSC_QUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace lhco {
+/*
+ * Bounded lock-free queue between exactly one producer thread and one
+ * consumer thread. push and pop spin (yielding the CPU) while the queue is
+ * full or empty.
+ */
+template <typename T>
+class SpscQueue {
+private:
+    std::vector<T> slots_;
+    char pad0_[64];
+    std::atomic<std::size_t> head_;  // next slot to pop, owned by consumer
+    char pad1_[64];
+    std::atomic<std::size_t> tail_;  // next slot to push, owned by producer
+    char pad2_[64];
+
+public:
+    explicit SpscQueue(std::size_t capacity)
+        : slots_(capacity + 1), head_(0), tail_(0) {}
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    bool try_push(T &&v) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        std::size_t next = tail + 1;
+        if (next == slots_.size()) { next = 0; }
+        if (next == head_.load(std::memory_order_acquire)) { return false; }
+        slots_[tail] = std::move(v);
+        tail_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T *v) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) { return false; }
+        *v = std::move(slots_[head]);
+        std::size_t next = head + 1;
+        if (next == slots_.size()) { next = 0; }
+        head_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    void push(T &&v) {
+        while (!try_push(std::move(v))) { std::this_thread::yield(); }
+    }
+
+    void pop(T *v) {
+        while (!try_pop(v)) { std::this_thread::yield(); }
+    }
+};
+}  // namespace lhco
+
+#endif  // SRC_SPSC_QUEUE_H_
@@ -0,0 +1,212 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#ifndef SRC_STATIC_SELECTION_H_
+#define SRC_STATIC_SELECTION_H_
+
+#include <cmath>
+#include <vector>
+#include "cut_flow.h"
+#include "object.h"
+
+/*
+ * Selections with the particle kind, the thresholds, and the comparisons
+ * fixed at compile time, for analyses whose cuts are hard-coded. Everything
+ * is inlined into the caller, and the objects are counted without branches.
+ *
+ * The thresholds are template parameters Num / Den, e.g., PtAbove<20> for
+ * pt > 20 GeV and AbsEtaBelow<25, 10> for |eta| < 2.5. For example,
+ *
+ *   using GoodJet = Both<PtAbove<30>, AbsEtaBelow<25, 10>>;
+ *   using Selection =
+ *       AllOf<NumOf<ObjectKind::AllJet, GoodJet, Comparison::GreaterEqual, 2>,
+ *             MissingETAbove<100>>;
+ *   if (Selection::pass(ev)) { ... }
+ *
+ * works for both Event and FlatEvent, and counts the same objects as numAllJet
+ * with Pt(30) and Eta(2.5).
+ */
+namespace lhco {
+template <int Num, int Den = 1>
+struct PtAbove {
+    template <typename P>
+    static bool pass(const P &p) {
+        return p.pt() > static_cast<double>(Num) / Den;
+    }
+};
+
+template <int Num, int Den = 1>
+struct AbsEtaBelow {
+    template <typename P>
+    static bool pass(const P &p) {
+        return std::abs(p.eta()) < static_cast<double>(Num) / Den;
+    }
+};
+
+// Any particle.
+struct Everything {
+    template <typename P>
+    static bool pass(const P &) {
+        return true;
+    }
+};
+
+// Both selections, evaluated without short-circuiting to avoid branches.
+template <typename First, typename Second>
+struct Both {
+    template <typename P>
+    static bool pass(const P &p) {
+        return First::pass(p) & Second::pass(p);
+    }
+};
+
+// The number of particles passing the selection.
+template <typename Selection, typename T>
+inline int countIf(const std::vector<T> &ps) {
+    int n = 0;
+    for (const auto &p : ps) { n += Selection::pass(p); }
+    return n;
+}
+
+template <ObjectKind Kind>
+struct CollectionOf;
+
+template <>
+struct CollectionOf<ObjectKind::Photon> {
+    template <typename E>
+    static auto get(const E &ev) -> decltype(ev.photon()) {
+        return ev.photon();
+    }
+};
+
+template <>
+struct CollectionOf<ObjectKind::Electron> {
+    template <typename E>
+    static auto get(const E &ev) -> decltype(ev.electron()) {
+        return ev.electron();
+    }
+};
+
+template <>
+struct CollectionOf<ObjectKind::Muon> {
+    template <typename E>
+    static auto get(const E &ev) -> decltype(ev.muon()) {
+        return ev.muon();
+    }
+};
+
+template <>
+struct CollectionOf<ObjectKind::Tau> {
+    template <typename E>
+    static auto get(const E &ev) -> decltype(ev.tau()) {
+        return ev.tau();
+    }
+};
+
+template <>
+struct CollectionOf<ObjectKind::NormalJet> {
+    template <typename E>
+    static auto get(const E &ev) -> decltype(ev.jet()) {
+        return ev.jet();
+    }
+};
+
+template <>
+struct CollectionOf<ObjectKind::Bjet> {
+    template <typename E>
+    static auto get(const E &ev) -> decltype(ev.bjet()) {
+        return ev.bjet();
+    }
+};
+
+// The number of objects of the kind passing the selection.
+template <ObjectKind Kind, typename Selection = Everything>
+struct Count {
+    template <typename E>
+    static int of(const E &ev) {
+        return countIf<Selection>(CollectionOf<Kind>::get(ev));
+    }
+};
+
+template <typename Selection>
+struct Count<ObjectKind::AllJet, Selection> {
+    template <typename E>
+    static int of(const E &ev) {
+        return Count<ObjectKind::NormalJet, Selection>::of(ev) +
+               Count<ObjectKind::Bjet, Selection>::of(ev);
+    }
+};
+
+template <Comparison Cmp>
+inline bool compareWith(double x, double value);
+
+template <>
+inline bool compareWith<Comparison::Equal>(double x, double value) {
+    return x == value;
+}
+
+template <>
+inline bool compareWith<Comparison::NotEqual>(double x, double value) {
+    return x != value;
+}
+
+template <>
+inline bool compareWith<Comparison::Less>(double x, double value) {
+    return x < value;
+}
+
+template <>
+inline bool compareWith<Comparison::LessEqual>(double x, double value) {
+    return x <= value;
+}
+
+template <>
+inline bool compareWith<Comparison::Greater>(double x, double value) {
+    return x > value;
+}
+
+template <>
+inline bool compareWith<Comparison::GreaterEqual>(double x, double value) {
+    return x >= value;
+}
+
+// Requires the number of objects of the kind passing the selection to
+// satisfy Cmp N.
+template <ObjectKind Kind, typename Selection, Comparison Cmp, int N>
+struct NumOf {
+    template <typename E>
+    static bool pass(const E &ev) {
+        return compareWith<Cmp>(Count<Kind, Selection>::of(ev), N);
+    }
+};
+
+// Requires missingET(ev) > Num / Den.
+template <int Num, int Den = 1>
+struct MissingETAbove {
+    template <typename E>
+    static bool pass(const E &ev) {
+        return ev.met().pt() > static_cast<double>(Num) / Den;
+    }
+};
+
+// All the event selections, in order, stopping at the first failure.
+template <typename... Cuts>
+struct AllOf;
+
+template <>
+struct AllOf<> {
+    template <typename E>
+    static bool pass(const E &) {
+        return true;
+    }
+};
+
+template <typename First, typename... Rest>
+struct AllOf<First, Rest...> {
+    template <typename E>
+    static bool pass(const E &ev) {
+        return First::pass(ev) && AllOf<Rest...>::pass(ev);
+    }
+};
+}  // namespace lhco
+
+#endif  // SRC_STATIC_SELECTION_H_
@@ -0,0 +1,144 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#include "stats.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif  // HAVE_CONFIG_H
+
+namespace lhco {
+const int kNumStatCounters = static_cast<int>(StatCounter::NumCounters);
+const int kNumStatStages = static_cast<int>(StatStage::NumStages);
+
+// Zero-initialized before any dynamic initialization.
+std::atomic<std::uint64_t> stat_counters[kNumStatCounters];
+std::atomic<std::uint64_t> stat_stage_calls[kNumStatStages];
+std::atomic<std::uint64_t> stat_stage_ns[kNumStatStages];
+
+std::mutex stats_at_exit_mutex;
+std::string stats_at_exit_filename;
+
+void writeStatsFile(const std::string &filename) {
+    if (filename.empty()) { return; }
+    if (filename == "-") {
+        writeStatsJson(&std::cerr);
+        return;
+    }
+    std::ofstream os(filename);
+    if (os) {
+        writeStatsJson(&os);
+    } else {
+        std::cerr << "-- Cannot write the statistics to \"" << filename
+                  << "\".\n";
+    }
+}
+
+void writeStatsOnExit() {
+    std::string filename;
+    {
+        std::lock_guard<std::mutex> lock(stats_at_exit_mutex);
+        filename = stats_at_exit_filename;
+    }
+    writeStatsFile(filename);
+}
+
+bool registerOnExit() {
+    std::atexit(writeStatsOnExit);
+    return true;
+}
+
+// Honors LHCO_STATS for any program linked with a library that has stats.
+struct StatsFromEnvironment {
+    StatsFromEnvironment() {
+        if (!statsEnabled()) { return; }
+        const char *filename = std::getenv("LHCO_STATS");
+        if (filename != nullptr && *filename != '\0') {
+            writeStatsAtExit(filename);
+        }
+    }
+} stats_from_environment;
+
+const char *statName(StatCounter c) {
+    static const char *names[] = {
+        "bytes_read", "lines",     "comment_lines", "undefined_lines",
+        "events",     "photons",   "electrons",     "muons",
+        "taus",       "jets",      "bjets",         "missing_ets",
+        "bytes_written"};
+    const int i = static_cast<int>(c);
+    return i >= 0 && i < kNumStatCounters ? names[i] : "";
+}
+
+const char *statName(StatStage s) {
+    static const char *names[] = {"parse", "dispatch", "sort", "output"};
+    const int i = static_cast<int>(s);
+    return i >= 0 && i < kNumStatStages ? names[i] : "";
+}
+
+bool statsEnabled() {
+#ifdef ENABLE_STATS
+    return true;
+#else
+    return false;
+#endif  // ENABLE_STATS
+}
+
+std::uint64_t statCount(StatCounter c) {
+    return stat_counters[static_cast<int>(c)].load(std::memory_order_relaxed);
+}
+
+std::uint64_t statCalls(StatStage s) {
+    const int i = static_cast<int>(s);
+    return stat_stage_calls[i].load(std::memory_order_relaxed);
+}
+
+std::uint64_t statNanoseconds(StatStage s) {
+    return stat_stage_ns[static_cast<int>(s)].load(std::memory_order_relaxed);
+}
+
+void resetStats() {
+    for (auto &c : stat_counters) { c.store(0, std::memory_order_relaxed); }
+    for (auto &c : stat_stage_calls) { c.store(0, std::memory_order_relaxed); }
+    for (auto &t : stat_stage_ns) { t.store(0, std::memory_order_relaxed); }
+}
+
+void writeStatsJson(std::ostream *os) {
+    *os << "{\n  \"enabled\": " << (statsEnabled() ? "true" : "false")
+        << ",\n  \"counters\": {";
+    for (int i = 0; i < kNumStatCounters; ++i) {
+        const auto c = static_cast<StatCounter>(i);
+        *os << (i == 0 ? "\n" : ",\n") << "    \"" << statName(c)
+            << "\": " << statCount(c);
+    }
+    *os << "\n  },\n  \"stages\": {";
+    for (int i = 0; i < kNumStatStages; ++i) {
+        const auto s = static_cast<StatStage>(i);
+        *os << (i == 0 ? "\n" : ",\n") << "    \"" << statName(s)
+            << "\": {\"calls\": " << statCalls(s)
+            << ", \"ns\": " << statNanoseconds(s) << "}";
+    }
+    *os << "\n  }\n}\n";
+}
+
+void writeStatsAtExit(const std::string &filename) {
+    static const bool registered = registerOnExit();
+    static_cast<void>(registered);
+    std::lock_guard<std::mutex> lock(stats_at_exit_mutex);
+    stats_at_exit_filename = filename;
+}
+
+void addStatCount(StatCounter c, std::uint64_t n) {
+    stat_counters[static_cast<int>(c)].fetch_add(n, std::memory_order_relaxed);
+}
+
+void addStatTime(StatStage s, std::uint64_t ns) {
+    const int i = static_cast<int>(s);
+    stat_stage_calls[i].fetch_add(1, std::memory_order_relaxed);
+    stat_stage_ns[i].fetch_add(ns, std::memory_order_relaxed);
+}
+}  // namespace lhco
@@ -0,0 +1,102 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#ifndef SRC_STATS_H_
+#define SRC_STATS_H_
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace lhco {
+/*
+ * Runtime statistics of the parsers and the event loop. They are collected
+ * only if the library is configured with --enable-stats. Otherwise the hooks
+ * compile to nothing and all the counters stay at zero.
+ *
+ * The counters are shared by all threads. The parsers add to them once per
+ * event, so that the overhead does not grow with the number of lines.
+ */
+enum class StatCounter {
+    BytesRead,       // bytes consumed by parseRawEvent
+    Lines,           // lines read, including the comment lines
+    CommentLines,    // lines containing '#'
+    UndefinedLines,  // records with an unknown type, which end the input
+    Events,          // events completed by parseRawEvent
+    Photons,         // objects dispatched by mkEvent, by type
+    Electrons,
+    Muons,
+    Taus,
+    Jets,
+    BJets,
+    MissingETs,
+    BytesWritten,  // bytes formatted by LhcoWriter
+    NumCounters
+};
+
+enum class StatStage {
+    Parse,     // parseRawEvent
+    Dispatch,  // mkEvent, without sorting the particles
+    Sort,      // Event::sort_particles
+    Output,    // operator<< of RawEvent and LhcoWriter
+    NumStages
+};
+
+const char *statName(StatCounter c);
+const char *statName(StatStage s);
+
+// True if the library has been built with --enable-stats.
+bool statsEnabled();
+
+std::uint64_t statCount(StatCounter c);
+// Number of times the stage has been entered, and the total time spent in it.
+std::uint64_t statCalls(StatStage s);
+std::uint64_t statNanoseconds(StatStage s);
+
+void resetStats();
+
+// Writes all the counters and the stages as a JSON object.
+void writeStatsJson(std::ostream *os);
+
+/*
+ * Writes the statistics as JSON to the file when the program exits ("-" for
+ * the standard error). The file can also be given by the LHCO_STATS
+ * environment variable.
+ */
+void writeStatsAtExit(const std::string &filename);
+
+void addStatCount(StatCounter c, std::uint64_t n);
+void addStatTime(StatStage s, std::uint64_t ns);
+
+// Adds the time from its construction to its destruction to the stage.
+class StageTimer {
+private:
+    StatStage stage_;
+    std::chrono::steady_clock::time_point start_;
+
+public:
+    explicit StageTimer(StatStage stage)
+        : stage_(stage), start_(std::chrono::steady_clock::now()) {}
+    ~StageTimer() {
+        using std::chrono::nanoseconds;
+        const auto elapsed = std::chrono::steady_clock::now() - start_;
+        addStatTime(stage_,
+                    std::chrono::duration_cast<nanoseconds>(elapsed).count());
+    }
+    StageTimer(const StageTimer &) = delete;
+    StageTimer &operator=(const StageTimer &) = delete;
+};
+}  // namespace lhco
+
+// The hooks used inside the library, enabled by ENABLE_STATS in config.h.
+#ifdef ENABLE_STATS
+#define LHCO_STAT_ADD(counter, n) \
+    ::lhco::addStatCount(::lhco::StatCounter::counter, n)
+#define LHCO_STAT_TIMER(stage) \
+    ::lhco::StageTimer lhco_stage_timer_(::lhco::StatStage::stage)
+#else
+#define LHCO_STAT_ADD(counter, n) static_cast<void>(n)
+#define LHCO_STAT_TIMER(stage) static_cast<void>(0)
+#endif  // ENABLE_STATS
+
+#endif  // SRC_STATS_H_
@@ -0,0 +1,103 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#include "synthetic.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include "event.h"
+#include "lhco.h"
+#include "object.h"
+
+namespace lhco {
+// splitmix64.
+std::uint64_t SyntheticGenerator::next() {
+    std::uint64_t z = (state_ += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+double SyntheticGenerator::uniform(double low, double high) {
+    // The upper 53 bits over 2^53, in [0, 1).
+    return low + (high - low) * ((next() >> 11) / 9007199254740992.0);
+}
+
+int SyntheticGenerator::multiplicity(double mean) {
+    return mean > 0.0 ? static_cast<int>(uniform(0.0, 2.0 * mean + 1.0)) : 0;
+}
+
+RawEvent SyntheticGenerator::next_event() {
+    RawEvent ev;
+    if (done()) { return ev; }
+    ++count_;
+
+    Objects objs;
+    auto add = [&](int typ, int num) {
+        for (int i = 0; i < num; ++i) {
+            const double pt = -50.0 * std::log(1.0 - uniform(0.0, 1.0));
+            const double jmass = typ == 4 ? uniform(0.0, 30.0) : 0.0;
+            int ntrk = 0, btag = 0;
+            if (typ == 1 || typ == 2) { ntrk = next() % 2 ? 1 : -1; }
+            if (typ == 3) { ntrk = next() % 2 ? 3 : -3; }
+            if (typ == 4) {
+                ntrk = static_cast<int>(next() % 20);
+                if (uniform(0.0, 1.0) < config_.bjet_fraction) {
+                    btag = next() % 2 ? 1 : 2;
+                }
+            }
+            objs.push_back(Object(typ, uniform(-4.0, 4.0),
+                                  uniform(0.0, 6.283), pt, jmass, ntrk, btag,
+                                  uniform(0.0, 20.0)));
+        }
+    };
+    add(0, multiplicity(config_.mean_photons));
+    add(1, multiplicity(config_.mean_electrons));
+    add(2, multiplicity(config_.mean_muons));
+    add(3, multiplicity(config_.mean_taus));
+    add(4, multiplicity(config_.mean_jets));
+    objs.push_back(Object(6, 0.0, uniform(0.0, 6.283),
+                          -40.0 * std::log(1.0 - uniform(0.0, 1.0)), 0.0, 0,
+                          0, 0.0));
+
+    const int event_number = static_cast<int>(count_);
+    ev.set_event(Header(event_number, static_cast<int>(next() % 10000)),
+                 std::move(objs));
+    return ev;
+}
+
+std::size_t writeSynthetic(const SyntheticConfig &config, std::ostream *os) {
+    SyntheticConfig gen_config = config;
+    if (config.num_bytes > 0) {
+        gen_config.num_events = std::numeric_limits<std::size_t>::max();
+    }
+    SyntheticGenerator gen(gen_config);
+    std::ostringstream buf;
+    buf << openingLine() << '\n';
+    std::size_t num_bytes = 0;
+    for (std::size_t i = 1; !gen.done(); ++i) {
+        if (config.num_bytes > 0 &&
+            num_bytes + static_cast<std::size_t>(buf.tellp()) >=
+                config.num_bytes) {
+            break;
+        }
+        buf << gen.next_event() << '\n';
+        if (config.comment_every > 0 && i % config.comment_every == 0) {
+            buf << "# synthetic event " << i << '\n';
+        }
+        if (buf.tellp() > (1 << 20)) {
+            const std::string s = buf.str();
+            os->write(s.data(), s.size());
+            num_bytes += s.size();
+            buf.str("");
+        }
+    }
+    const std::string s = buf.str();
+    os->write(s.data(), s.size());
+    return num_bytes + s.size();
+}
+}  // namespace lhco
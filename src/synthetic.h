@@ -0,0 +1,62 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#ifndef SRC_SYNTHETIC_H_
+#define SRC_SYNTHETIC_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include "event.h"
+
+namespace lhco {
+/*
+ * Settings of the synthetic LHCO events. The number of objects of each type
+ * in an event is uniform in [0, 2 * mean], and a comment line follows every
+ * comment_every-th event (never if zero). If num_bytes is not zero,
+ * writeSynthetic writes events until the output reaches that size instead
+ * of writing num_events.
+ */
+struct SyntheticConfig {
+    std::size_t num_events = 100000;
+    std::size_t num_bytes = 0;
+    std::uint64_t seed = 1;
+    double mean_photons = 0.5;
+    double mean_electrons = 0.5;
+    double mean_muons = 0.5;
+    double mean_taus = 0.25;
+    double mean_jets = 4.0;
+    double bjet_fraction = 0.2;
+    std::size_t comment_every = 20;
+};
+
+/*
+ * Deterministic generator of LHCO events: the same settings give the same
+ * bytes on every platform, as it has its own random number generator and
+ * writes the events with the output operators.
+ */
+class SyntheticGenerator {
+private:
+    SyntheticConfig config_;
+    std::uint64_t state_;
+    std::size_t count_ = 0;
+
+    std::uint64_t next();
+    double uniform(double low, double high);
+    int multiplicity(double mean);
+
+public:
+    explicit SyntheticGenerator(const SyntheticConfig &config)
+        : config_(config), state_(config.seed) {}
+
+    bool done() const { return count_ >= config_.num_events; }
+    RawEvent next_event();
+};
+
+/*
+ * Writes the column titles and all the events of the config. Returns the
+ * number of bytes written.
+ */
+std::size_t writeSynthetic(const SyntheticConfig &config, std::ostream *os);
+}  // namespace lhco
+
+#endif  // SRC_SYNTHETIC_H_
@@ -1,9 +1,9 @@
 /* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
 
-#include <fstream>
 #include <iostream>
 #include "kinematics.h"
 #include "lhco.h"
+#include "reader.h"
 
 double invMass(const lhco::Event &lhco) {
     double invmass = 0.0;
@@ -24,19 +24,18 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
-    std::ifstream filename(argv[1]);
-    if (!filename) {
+    lhco::EventReader events(argv[1]);
+    if (!events.is_open()) {
         std::cerr << "-- Cannot open input file \"" << argv[1] << "\".\n";
         return 1;
     } else {
         std::cout << "-- Reading \"" << argv[1] << "\" ...\n";
     }
 
-    lhco::Event lhco = lhco::parseEvent(&filename);
     lhco::Pt ptcut(30.0);
     lhco::Eta etacut(2.0);
     int num_eve = 0;
-    for (; !lhco.empty(); lhco = lhco::parseEvent(&filename)) {
+    for (const lhco::Event &lhco : events) {
         ++num_eve;
         std::cout << "-- Event number: " << num_eve << '\n'
                   << lhco.show() << '\n';
@@ -60,5 +59,5 @@ int main(int argc, char *argv[]) {
     }
 
     std::cout << "-- " << num_eve << " events parsed.\n";
-    filename.close();
+    events.close();
 }
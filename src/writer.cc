@@ -0,0 +1,145 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#include "writer.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif  // HAVE_CONFIG_H
+#include "parallel.h"
+#include "stats.h"
+
+namespace lhco {
+// As `os << std::setw(width) << v`.
+void formatInt(int v, int width, std::string *out) {
+    char digits[16];
+    int n = 0;
+    const std::uint32_t abs_v = static_cast<std::uint32_t>(v);
+    std::uint32_t u = v < 0 ? 0u - abs_v : abs_v;
+    do {
+        digits[n++] = static_cast<char>('0' + u % 10);
+        u /= 10;
+    } while (u > 0);
+    if (v < 0) { digits[n++] = '-'; }
+    if (width > n) { out->append(width - n, ' '); }
+    while (n > 0) { out->push_back(digits[--n]); }
+}
+
+// As `os << std::fixed << std::setprecision(precision) << std::setw(width)
+// << v`. precision must be at most 3.
+void formatFixed(double v, int precision, int width, std::string *out) {
+    static const std::uint64_t pow10[] = {1, 10, 100, 1000};
+    const double scaled = std::abs(v) * pow10[precision];
+    const double whole = std::floor(scaled);
+    const double frac = scaled - whole;
+
+    // Values close to a tie, or too large for the error of the product to be
+    // negligible, are left to printf.
+    if (!(scaled < 1e9) || std::abs(frac - 0.5) < 1e-6) {
+        char buf[64];
+        const int len = std::snprintf(buf, sizeof buf, "%*.*f", width,
+                                      precision, v);
+        if (len >= 0 && static_cast<std::size_t>(len) < sizeof buf) {
+            out->append(buf, len);
+            return;
+        }
+        std::vector<char> large(len + 1);
+        std::snprintf(large.data(), large.size(), "%*.*f", width, precision,
+                      v);
+        out->append(large.data(), len);
+        return;
+    }
+
+    std::uint64_t rounded = static_cast<std::uint64_t>(whole);
+    if (frac > 0.5) { ++rounded; }
+    std::uint64_t int_part = rounded / pow10[precision];
+    std::uint64_t frac_part = rounded % pow10[precision];
+
+    char digits[32];
+    int n = 0;
+    for (int i = 0; i < precision; ++i) {
+        digits[n++] = static_cast<char>('0' + frac_part % 10);
+        frac_part /= 10;
+    }
+    if (precision > 0) { digits[n++] = '.'; }
+    do {
+        digits[n++] = static_cast<char>('0' + int_part % 10);
+        int_part /= 10;
+    } while (int_part > 0);
+    if (std::signbit(v)) { digits[n++] = '-'; }
+    if (width > n) { out->append(width - n, ' '); }
+    while (n > 0) { out->push_back(digits[--n]); }
+}
+
+void formatHeader(const Header &h, std::string *out) {
+    formatInt(h.event_number, 14, out);
+    formatInt(h.trigger_word, 7, out);
+}
+
+void formatObject(const Object &obj, std::string *out) {
+    formatInt(obj.typ, 5, out);
+    formatFixed(obj.eta, 3, 9, out);
+    formatFixed(obj.phi, 3, 7, out);
+    formatFixed(obj.pt, 2, 8, out);
+    formatFixed(obj.jmass, 2, 8, out);
+    formatFixed(static_cast<double>(obj.ntrk), 1, 6, out);
+    formatFixed(static_cast<double>(obj.btag), 1, 6, out);
+    formatFixed(obj.hadem, 2, 9, out);
+}
+
+void formatRawEvent(const RawEvent &ev, std::string *out) {
+    formatInt(0, 3, out);
+    formatHeader(ev.header(), out);
+    out->push_back('\n');
+    int counter = 1;
+    for (const auto &obj : ev.objects()) {
+        formatInt(counter, 3, out);
+        formatObject(obj, out);
+        out->append("   0.0   0.0");  // dummy columns
+        if (obj.typ != 6) { out->push_back('\n'); }
+        ++counter;
+    }
+}
+
+void LhcoWriter::write(const RawEvent &ev) {
+    LHCO_STAT_TIMER(Output);
+    const std::size_t size = buffer_.size();
+    formatRawEvent(ev, &buffer_);
+    buffer_.push_back('\n');
+    LHCO_STAT_ADD(BytesWritten, buffer_.size() - size);
+    if (buffer_.size() >= buffer_size_) { flush(); }
+}
+
+void LhcoWriter::write(const std::vector<RawEvent> &evs,
+                       unsigned num_threads) {
+    LHCO_STAT_TIMER(Output);
+    if (num_threads == 0) { num_threads = defaultNumThreads(); }
+    const std::size_t num_blocks =
+        evs.size() < 4 * num_threads ? evs.size() : 4 * num_threads;
+    std::vector<std::string> blocks(num_blocks);
+    parallelFor(num_blocks, num_threads, [&](std::size_t i) {
+        const std::size_t first = evs.size() * i / num_blocks;
+        const std::size_t last = evs.size() * (i + 1) / num_blocks;
+        for (std::size_t j = first; j < last; ++j) {
+            formatRawEvent(evs[j], &blocks[i]);
+            blocks[i].push_back('\n');
+        }
+    });
+
+    flush();
+    for (const auto &block : blocks) {
+        os_->write(block.data(), block.size());
+        LHCO_STAT_ADD(BytesWritten, block.size());
+    }
+}
+
+void LhcoWriter::flush() {
+    if (!buffer_.empty()) {
+        os_->write(buffer_.data(), buffer_.size());
+        buffer_.clear();
+    }
+}
+}  // namespace lhco
@@ -0,0 +1,58 @@
+/* Copyright (c) 2015, 2017, Chan Beom Park <cbpark@gmail.com> */
+
+#ifndef SRC_WRITER_H_
+#define SRC_WRITER_H_
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "event.h"
+#include "object.h"
+
+namespace lhco {
+/*
+ * Append the same bytes as the output operators of Header, Object, and
+ * RawEvent write to a stream with the default format flags, without going
+ * through iostreams.
+ */
+void formatHeader(const Header &h, std::string *out);
+
+void formatObject(const Object &obj, std::string *out);
+
+void formatRawEvent(const RawEvent &ev, std::string *out);
+
+/*
+ * Writes events in the LHCO format into a large buffer that is flushed to
+ * the stream when it is full. Each event is written as `os << ev << '\n'`
+ * would write it.
+ */
+class LhcoWriter {
+private:
+    std::ostream *os_;
+    std::size_t buffer_size_;
+    std::string buffer_;
+
+public:
+    static const std::size_t kDefaultBufferSize = 4 << 20;
+
+    explicit LhcoWriter(std::ostream *os,
+                        std::size_t buffer_size = kDefaultBufferSize)
+        : os_(os), buffer_size_(buffer_size) {
+        buffer_.reserve(buffer_size_);
+    }
+    ~LhcoWriter() { flush(); }
+    LhcoWriter(const LhcoWriter &) = delete;
+    LhcoWriter &operator=(const LhcoWriter &) = delete;
+
+    void write(const RawEvent &ev);
+    /*
+     * Formats the events on num_threads threads (all hardware threads if
+     * zero), each into its own buffer, and writes the buffers in order.
+     */
+    void write(const std::vector<RawEvent> &evs, unsigned num_threads = 0);
+    void flush();
+};
+}  // namespace lhco
+
+#endif  // SRC_WRITER_H_